@@ -0,0 +1,963 @@
+/*
+*******************************************************************************
+\file bench.cpp
+\brief Benchmarks
+\project GF2 [algebra over GF(2)]
+\created 2026.10.16
+\version 2026.10.17
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file bench.cpp
+\brief Замеры производительности
+
+Программа benchgf2 замеряет скорость основных операций библиотеки:
+операций со словами (WW), с числами (ZZ), с многочленами (MP), с многочленами
+над словарями мономов (MT), с системами многочленов (MI), вычисления базисов
+Гребнера (Buchb, BuchbBatch), перебора решений (Exhaust), решения систем
+линеаризацией (XL) и угадыванием переменных (Hybrid), смены порядка базисов
+Гребнера (FGLM), предобработки систем (ElimLin), операций с плотными
+и разреженными матрицами (Mat, SMat) и характеристик булевых и векторных
+булевых функций (Func).
+
+Входные данные замеров генерируются с фиксированными начальными значениями
+генератора Env::Rand(), поэтому результаты воспроизводимы. Каждый замер
+выполняется несколько раз, в качестве результата выбирается медиана
+времени (в наносекундах) одной итерации.
+
+Запуск:
+\code
+	benchgf2 [-o out.json] [-b base.json] [-t tol] [-r reps] [-f filter]
+\endcode
+-	-o: результаты записываются в файл out.json (JSON);
+-	-b: результаты сравниваются с сохраненными ранее в base.json;
+-	-t: допустимое относительное замедление (0.1 по умолчанию);
+-	-r: число повторов каждого замера (5 по умолчанию);
+-	-f: выполняются только замеры, название которых содержит filter.
+
+Если при сравнении с base.json какой-либо замер замедлился больше, чем
+на tol, то он помечается как регрессия, а программа возвращает
+ненулевой код.
+
+Эталонные результаты хранятся в файле bench/baseline.json. Времена зависят
+от платформы, поэтому перед сравнением эталон следует обновить на своей
+машине (без фоновой нагрузки):
+\code
+	benchgf2 -r 9 -o bench/baseline.json
+\endcode
+Эталон в репозитории также обновляется после изменений, которые намеренно
+влияют на скорость (ускорение, новые замеры). Новый эталон фиксируется
+в том же коммите, что и изменение.
+*******************************************************************************
+*/
+
+#include "gf2/batch.h"
+#include "gf2/buchb.h"
+#include "gf2/elimlin.h"
+#include "gf2/eval.h"
+#include "gf2/exhaust.h"
+#include "gf2/fglm.h"
+#include "gf2/func.h"
+#include "gf2/hybrid.h"
+#include "gf2/io.h"
+#include "gf2/mat.h"
+#include "gf2/mi.h"
+#include "gf2/mt.h"
+#include "gf2/smat.h"
+#include "gf2/xl.h"
+#include "gf2/zz.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace GF2;
+using namespace std;
+
+/*
+*******************************************************************************
+Инфраструктура замеров
+*******************************************************************************
+*/
+
+struct Result
+{
+	string name;	//< название замера
+	size_t iters;	//< число итераций в одном повторе
+	double ns;		//< медиана времени одной итерации (в наносекундах)
+};
+
+static vector<Result> _results;		//< результаты
+static const char* _filter = 0;		//< фильтр названий
+static size_t _reps = 5;			//< число повторов
+static volatile word _sink;			//< приемник результатов вычислений
+
+// не дать компилятору исключить вычисления
+template<class _T> inline void Keep(const _T& val)
+{
+	_sink = _sink + (word)sizeof(val) + *(const octet*)&val;
+}
+
+// время в наносекундах
+static double Nanos()
+{
+	using namespace std::chrono;
+	return (double)duration_cast<nanoseconds>(
+		steady_clock::now().time_since_epoch()).count();
+}
+
+// выполнить замер
+template<class _F> void Bench(const string& name, _F f)
+{
+	// фильтр?
+	if (_filter && name.find(_filter) == string::npos)
+		return;
+	// подбор числа итераций: повтор должен длиться не менее 50 ms
+	size_t iters = 1;
+	double elapsed;
+	while (1)
+	{
+		double start = Nanos();
+		for (size_t i = 0; i < iters; ++i)
+			f();
+		elapsed = Nanos() - start;
+		if (elapsed >= 5e7 || iters >= (SIZE_MAX >> 1))
+			break;
+		iters *= (elapsed < 5e6) ? 10 : 2;
+	}
+	// повторы
+	vector<double> samples;
+	for (size_t rep = 0; rep < _reps; ++rep)
+	{
+		double start = Nanos();
+		for (size_t i = 0; i < iters; ++i)
+			f();
+		samples.push_back((Nanos() - start) / iters);
+	}
+	sort(samples.begin(), samples.end());
+	Result res = { name, iters, samples[samples.size() / 2] };
+	_results.push_back(res);
+	Env::Print("%-40s %14.1f ns %10zu it\n", name.c_str(), res.ns, iters);
+}
+
+// название с параметром
+static string Name(const char* prefix, size_t n, const char* suffix)
+{
+	char buf[128];
+	::snprintf(buf, sizeof(buf), "%s<%zu>::%s", prefix, n, suffix);
+	return buf;
+}
+
+// случайный многочлен из count мономов степени не выше deg
+template<size_t _n, class _O>
+MP<_n, _O>& RandPoly(MP<_n, _O>& poly, size_t count, size_t deg)
+{
+	poly.SetEmpty();
+	for (size_t i = 0; i < count; ++i)
+	{
+		MM<_n> m;
+		for (size_t d = Env::Rand() % (deg + 1); d--;)
+			m.Set(Env::Rand() % _n, 1);
+		poly.push_back(m);
+	}
+	poly.Normalize();
+	return poly;
+}
+
+// случайная система квадратичных уравнений с заданным наудачу решением
+template<size_t _n, class _O>
+MI<_n, _O>& RandQuadSystem(MI<_n, _O>& system, size_t count)
+{
+	WW<_n> x;
+	x.Rand();
+	system.SetEmpty();
+	for (size_t i = 0; i < count; ++i)
+	{
+		MP<_n, _O> poly;
+		MM<_n> m;
+		do if (m.Deg() <= 2 && (Env::Rand() & 1))
+			poly.push_back(m);
+		while (m.Next());
+		poly.Normalize();
+		// x -- решение
+		poly += poly.Calc(x);
+		system.Insert(poly);
+	}
+	return system;
+}
+
+/*
+*******************************************************************************
+Замеры WW
+*******************************************************************************
+*/
+
+template<size_t _n> void benchWW()
+{
+	Env::Seed(_n);
+	WW<_n> w1, w2;
+	w1.Rand(), w2.Rand();
+	Bench(Name("WW", _n, "Xor"), [&]() { w1 ^= w2; Keep(w1.GetWord(0)); });
+	Bench(Name("WW", _n, "And"), [&]() { w1 &= ~w2; Keep(w1.GetWord(0)); });
+	Bench(Name("WW", _n, "Weight"), [&]() { Keep(w1.Weight()); w1.Flip(3); });
+	Bench(Name("WW", _n, "ShLo"),
+		[&]() { (w1 = w2).ShLo(_n / 3); Keep(w1.GetWord(0)); });
+	Bench(Name("WW", _n, "ShHi"),
+		[&]() { (w1 = w2).ShHi(_n / 3); Keep(w1.GetWord(0)); });
+	Bench(Name("WW", _n, "Next"), [&]() { w1.Next(); Keep(w1.GetWord(0)); });
+	WW<_n> mask;
+	for (size_t pos = 0; pos < _n; pos += 3)
+		mask.Set(pos, 1);
+	Bench(Name("WW", _n, "Pack"),
+		[&]() { (w1 = w2).Pack(mask).Unpack(mask); Keep(w1.GetWord(0)); });
+}
+
+/*
+*******************************************************************************
+Замеры ZZ
+*******************************************************************************
+*/
+
+template<size_t _n> void benchZZ()
+{
+	Env::Seed(_n + 1);
+	ZZ<_n> z1, z2, z3;
+	z1.Rand(), z2.Rand();
+	z2.SetWord(z2.WordSize() - 1, 0);
+	z2.SetWord(0, z2.GetWord(0) | 1);
+	Bench(Name("ZZ", _n, "Mul"), [&]() { (z3 = z1) *= z2; Keep(z3); });
+	Bench(Name("ZZ", _n, "Div"), [&]() { (z3 = z1) /= z2; Keep(z3); });
+	// десятичная запись
+	string str;
+	{
+		stringstream ss;
+		ss << z1;
+		str = ss.str();
+	}
+	Bench(Name("ZZ", _n, "Out"), [&]()
+	{
+		stringstream ss;
+		ss << z1;
+		Keep(ss.str().size());
+	});
+	Bench(Name("ZZ", _n, "In"), [&]()
+	{
+		stringstream ss(str);
+		ss >> z3;
+		Keep(z3);
+	});
+}
+
+/*
+*******************************************************************************
+Замеры MP
+*******************************************************************************
+*/
+
+template<size_t _n> void benchMP()
+{
+	typedef MOGrevlex<_n> O;
+	Env::Seed(_n + 2);
+	MP<_n, O> p1, p2, p3, p4;
+	RandPoly(p1, 200, 4), RandPoly(p2, 200, 4);
+	RandPoly(p3, 20, 3), RandPoly(p4, 8, 2);
+	Bench(Name("MP", _n, "SymDiff"), [&]()
+	{
+		MP<_n, O> p(p1);
+		p += p2;
+		Keep(p.Size());
+	});
+	Bench(Name("MP", _n, "MultClassic"), [&]()
+	{
+		MP<_n, O> p(p1);
+		p.MultClassic(p3);
+		Keep(p.Size());
+	});
+	Bench(Name("MP", _n, "MultGB"), [&]()
+	{
+		MP<_n, O> p(p1);
+		p.MultGB(p3);
+		Keep(p.Size());
+	});
+	MP<_n, O> p13(p1);
+	p13 *= p3;
+	// нормализация: мономы p13 в случайном порядке
+	vector<MM<_n>> mons(p13.begin(), p13.end());
+	for (size_t i = mons.size(); i > 1; --i)
+		std::swap(mons[i - 1], mons[Env::Rand() % i]);
+	Bench(Name("MP", _n, "SortCmp"), [&]()
+	{
+		list<MM<_n>> l(mons.begin(), mons.end());
+		l.sort(O());
+		Keep(l.size());
+	});
+	Bench(Name("MP", _n, "Normalize"), [&]()
+	{
+		MP<_n, O> p;
+		p.assign(mons.begin(), mons.end());
+		p.Normalize();
+		Keep(p.Size());
+	});
+	Bench(Name("MP", _n, "NormalizeLex"), [&]()
+	{
+		MP<_n, MOLex<_n>> p;
+		p.assign(mons.begin(), mons.end());
+		p.Normalize();
+		Keep(p.Size());
+	});
+	Bench(Name("MP", _n, "ModClassic"), [&]()
+	{
+		MP<_n, O> p(p13);
+		p.ModClassic(p4);
+		Keep(p.Size());
+	});
+	Bench(Name("MP", _n, "ModGB"), [&]()
+	{
+		MP<_n, O> p(p13);
+		p.ModGB(p4);
+		Keep(p.Size());
+	});
+	Bench(Name("MP", _n, "ReplaceClassic"), [&]()
+	{
+		MP<_n, O> p(p1);
+		p.ReplaceClassic(1, p3);
+		Keep(p.Size());
+	});
+	Bench(Name("MP", _n, "ReplaceGB"), [&]()
+	{
+		MP<_n, O> p(p1);
+		p.ReplaceGB(1, p3);
+		Keep(p.Size());
+	});
+	// замена 8 переменных
+	map<size_t, MP<_n, O>> subst;
+	for (size_t v = 0; v < 8; ++v)
+		RandPoly(subst[v], 4, 2);
+	Bench(Name("MP", _n, "Replace8"), [&]()
+	{
+		MP<_n, O> p(p1);
+		for (auto iter = subst.begin(); iter != subst.end(); ++iter)
+			p.Replace(iter->first, iter->second);
+		Keep(p.Size());
+	});
+	Bench(Name("MP", _n, "Substitute8"), [&]()
+	{
+		MP<_n, O> p(p1);
+		p.Substitute(subst);
+		Keep(p.Size());
+	});
+	MI<_n, O> system;
+	for (size_t i = 0; i < 32; ++i)
+	{
+		MP<_n, O> p;
+		system.Insert(RandPoly(p, 50, 4));
+	}
+	Bench(Name("MI", _n, "Substitute8"), [&]()
+	{
+		MI<_n, O> s(system);
+		s.Substitute(subst);
+		Keep(s.Size());
+	});
+	Pool pool;
+	Bench(Name("MI", _n, "Substitute8Pool"), [&]()
+	{
+		MI<_n, O> s(system);
+		s.Substitute(subst, pool);
+		Keep(s.Size());
+	});
+	Bench(Name("MP", _n, "SPoly"), [&]()
+	{
+		MP<_n, O> p;
+		p.SPoly(p1, p2);
+		Keep(p.Size());
+	});
+	// вычисление в 512 точках
+	vector<WW<_n>> points(512);
+	for (size_t i = 0; i < points.size(); ++i)
+		points[i].Rand();
+	Bench(Name("MP", _n, "Calc512"), [&]()
+	{
+		size_t count = 0;
+		for (size_t i = 0; i < points.size(); ++i)
+			count += p1.Calc(points[i]);
+		Keep(count);
+	});
+	Eval<_n> eval(p1);
+	vector<word> res;
+	Bench(Name("Eval", _n, "Calc512"), [&]()
+	{
+		eval.Calc(points, res);
+		Keep(res[0]);
+	});
+	// текстовый ввод-вывод
+	string str;
+	Format(str, p13);
+	Bench(Name("MP", _n, "Out"), [&]()
+	{
+		stringstream ss;
+		ss << p13;
+		Keep(ss.str().size());
+	});
+	Bench(Name("MP", _n, "Format"), [&]()
+	{
+		string s;
+		Format(s, p13);
+		Keep(s.size());
+	});
+	Bench(Name("MP", _n, "In"), [&]()
+	{
+		stringstream ss(str);
+		MP<_n, O> p;
+		ss >> p;
+		Keep(p.Size());
+	});
+	Bench(Name("MP", _n, "Parse"), [&]()
+	{
+		const char* ptr = str.c_str();
+		MP<_n, O> p;
+		Parse(ptr, ptr + str.size(), p);
+		Keep(p.Size());
+	});
+}
+
+/*
+*******************************************************************************
+Замеры MT
+*******************************************************************************
+*/
+
+template<size_t _n> void benchMT()
+{
+	typedef MOGrevlex<_n> O;
+	Env::Seed(_n + 2);
+	MP<_n, O> p1, p2;
+	RandPoly(p1, 200, 4), RandPoly(p2, 200, 4);
+	MT<_n> table;
+	MTRank<_n, O> rank(table);
+	MTP<_n, O> t1(table, rank), t2(table, rank);
+	t1.From(p1), t2.From(p2);
+	rank.Update();
+	Bench(Name("MT", _n, "Insert"), [&]()
+	{
+		MTP<_n, O> t(table, rank);
+		t.From(p1);
+		Keep(t.size());
+	});
+	Bench(Name("MT", _n, "SymDiff"), [&]()
+	{
+		MTP<_n, O> t(t1);
+		t += t2;
+		Keep(t.size());
+	});
+	MM<_n> m(0, _n / 2);
+	Bench(Name("MT", _n, "Mult"), [&]()
+	{
+		MTP<_n, O> t(t1);
+		t *= m;
+		Keep(t.size());
+	});
+	MP<_n, O> q1(p1);
+	MTP<_n, O> u1(t1);
+	Bench(Name("MP", _n, "Equal"), [&]() { Keep(p1 == q1); });
+	Bench(Name("MT", _n, "Equal"), [&]() { Keep(t1 == u1); });
+}
+
+/*
+*******************************************************************************
+Замеры MI и Buchb
+*******************************************************************************
+*/
+
+template<size_t _n> void benchMI()
+{
+	typedef MOGrevlex<_n> O;
+	Env::Seed(_n + 3);
+	MI<_n, O> system, gb;
+	RandQuadSystem(system, _n + 2);
+	// базис Гребнера
+	Buchb<_n, O> bb;
+	Bench(Name("Buchb", _n, "Quad"), [&]()
+	{
+		bb.Init();
+		bb.Update(system);
+		bb.Process();
+		bb.Done(gb);
+		Keep(gb.Size());
+	});
+	// приведение
+	MP<_n, O> poly;
+	RandPoly(poly, 100, 4);
+	Bench(Name("MI", _n, "Reduce"), [&]()
+	{
+		MP<_n, O> p(poly);
+		gb.Reduce(p);
+		Keep(p.Size());
+	});
+	Bench(Name("MI", _n, "SelfReduce"), [&]()
+	{
+		MI<_n, O> s(system);
+		s.SelfReduce();
+		Keep(s.Size());
+	});
+	Pool pool;
+	Bench(Name("MI", _n, "SelfReducePool"), [&]()
+	{
+		MI<_n, O> s(system);
+		s.SelfReduce(pool);
+		Keep(s.Size());
+	});
+	Bench(Name("MI", _n, "IsGB"), [&]() { Keep(gb.IsGB()); });
+	Bench(Name("MI", _n, "IsGBPool"), [&]() { Keep(gb.IsGB(pool)); });
+	// базис факторкольца мономиального идеала
+	MI<_n, O> mons;
+	RandPoly(poly, _n, 3);
+	for (auto iter = poly.begin(); iter != poly.end(); ++iter)
+		if (iter->Deg() > 1)
+			mons.Insert(MP<_n, O>(*iter));
+	Bench(Name("MI", _n, "QuotientBasis"), [&]()
+	{
+		MP<_n, O> basis;
+		Keep(mons.QuotientBasis(basis));
+	});
+	Bench(Name("MI", _n, "EnumQuotientBasis"), [&]()
+	{
+		size_t deg = 0;
+		mons.EnumQuotientBasis([&](const MM<_n>& m) { deg += m.Deg(); });
+		Keep(deg);
+	});
+	Bench(Name("MI", _n, "QuotientBasisDim"), [&]()
+	{
+		Keep(mons.QuotientBasisDim().GetWord(0));
+	});
+	Bench(Name("MI", _n, "QuotientBasisDimPool"), [&]()
+	{
+		Keep(mons.QuotientBasisDim(pool).GetWord(0));
+	});
+}
+
+template<size_t _n> void benchBatch()
+{
+	typedef MOGrevlex<_n> O;
+	Env::Seed(_n + 7);
+	vector<MI<_n, O>> systems(64);
+	for (size_t i = 0; i < systems.size(); ++i)
+		RandQuadSystem(systems[i], _n + 2);
+	// последовательно
+	Buchb<_n, O> bb;
+	MI<_n, O> gb;
+	Bench(Name("Buchb", _n, "Quad64"), [&]()
+	{
+		for (size_t i = 0; i < systems.size(); ++i)
+		{
+			bb.Init();
+			bb.Update(systems[i]);
+			bb.Process();
+			bb.Done(gb);
+			Keep(gb.Size());
+		}
+	});
+	// пакетом
+	Pool pool;
+	BuchbBatch<_n, O> batch(pool);
+	Bench(Name("BuchbBatch", _n, "Quad64"), [&]()
+	{
+		batch.Process(systems, [&](size_t, MI<_n, O>& gb) { Keep(gb.Size()); },
+			false);
+	});
+}
+
+template<size_t _n> void benchExhaust()
+{
+	typedef MOGrevlex<_n> O;
+	Env::Seed(_n + 8);
+	MI<_n, O> system;
+	RandQuadSystem(system, _n + 2);
+	// прямая подстановка
+	Bench(Name("MP", _n, "CalcAll"), [&]()
+	{
+		size_t count = 0;
+		WW<_n> x;
+		for (word v = 0; v < (WORD_1 << _n); ++v)
+		{
+			x = v;
+			auto iter = system.begin();
+			while (iter != system.end() && !iter->Calc(x))
+				++iter;
+			count += iter == system.end();
+		}
+		Keep(count);
+	});
+	// код Грея
+	Pool pool;
+	Exhaust<_n, O> exhaust(pool);
+	Bench(Name("Exhaust", _n, "Quad"), [&]()
+	{
+		Keep(exhaust.Process(system, [](const WW<_n>&) {}));
+	});
+}
+
+static void benchMat()
+{
+	Env::Seed(9);
+	Mat a(2000, 20000), e;
+	a.Rand();
+	Bench("Mat::Echelon2000x20000", [&]() { e = a; Keep(e.Echelon()); });
+	Bench("Mat::EchelonNR2000x20000", [&]() { e = a; Keep(e.Echelon(false)); });
+	Pool pool;
+	Bench("Mat::EchelonPool2000x20000", [&]()
+	{
+		e = a;
+		Keep(e.Echelon(pool));
+	});
+	// 3/4 столбцов нулевые
+	for (size_t i = 0; i < a.Rows(); ++i)
+		for (size_t j = 0; j < a.Cols(); ++j)
+			if (j / 7 % 4 != 0)
+				a.Set(i, j, 0);
+	Bench("Mat::EchelonSparse2000x20000", [&]()
+	{
+		e = a;
+		Keep(e.Echelon());
+	});
+}
+
+static void benchSMat()
+{
+	typedef MOGrevlex<40> O;
+	Env::Seed(10);
+	// матрица Маколея: квадратичные многочлены, умноженные на переменные
+	MI<40, O> system, xl;
+	for (size_t e = 0; e < 80; ++e)
+	{
+		MP<40, O> poly;
+		for (size_t j = 0; j < 32; ++j)
+			poly += MM<40>(Env::Rand() % 40, Env::Rand() % 40);
+		system.Insert(poly);
+	}
+	for (auto iter = system.begin(); iter != system.end(); ++iter)
+	{
+		xl.Insert(*iter);
+		for (size_t i = 0; i < 40; ++i)
+			xl.Insert(*iter * MM<40>(i));
+	}
+	SMat a;
+	MP<40, O> mons;
+	a.From(xl, mons);
+	Mat d(a.Rows(), a.Cols());
+	for (size_t i = 0; i < a.Rows(); ++i)
+		for (size_t j : a.Row(i))
+			d.Set(i, j, 1);
+	Bench("Mat::RankMacaulay", [&]() { Keep(d.Rank()); });
+	Bench("SMat::RankMacaulay", [&]() { Keep(a.Rank()); });
+	// ядро разреженной матрицы
+	SMat b(4000, 4000);
+	for (size_t i = 0; i < b.Rows(); ++i)
+		for (size_t k = 0; k < 6; ++k)
+			b.Flip(i, Env::Rand() % b.Cols());
+	Pool pool;
+	Mat ker;
+	Bench("SMat::Kernel4000", [&]() { Keep(b.Kernel(ker, 4)); });
+	Bench("SMat::KernelPool4000", [&]() { Keep(b.Kernel(pool, ker, 4)); });
+}
+
+template<size_t _n> void benchXL()
+{
+	typedef MOGrevlex<_n> O;
+	Env::Seed(_n + 11);
+	// квадратичная система 2n x n с решением x0
+	MI<_n, O> system, lin;
+	WW<_n> x0;
+	x0.Rand();
+	for (size_t e = 0; e < 2 * _n; ++e)
+	{
+		MP<_n, O> poly;
+		for (size_t j = 0; j < 3 * _n; ++j)
+			poly += MM<_n>(Env::Rand() % _n, Env::Rand() % _n);
+		if (poly.Calc(x0))
+			poly += 1;
+		system.Insert(poly);
+	}
+	XL<_n, O> xl;
+	Bench(Name("XL", _n, "MutantQuad"), [&]()
+	{
+		Keep(xl.Process(system, lin));
+	});
+	xl.SetMutants(false);
+	Bench(Name("XL", _n, "Quad"), [&]()
+	{
+		Keep(xl.Process(system, lin));
+	});
+}
+
+template<size_t _n> void benchElimLin()
+{
+	typedef MOGrevlex<_n> O;
+	Env::Seed(_n + 12);
+	// квадратичные многочлены и линейные соотношения, скрытые в их суммах
+	MI<_n, O> system, s;
+	std::vector<MP<_n, O>> quads;
+	for (size_t e = 0; e < _n; ++e)
+	{
+		MP<_n, O> poly;
+		for (size_t j = 0; j < 2 * _n; ++j)
+			poly += MM<_n>(Env::Rand() % _n, Env::Rand() % _n);
+		quads.push_back(poly);
+		system.Insert(poly);
+	}
+	for (size_t e = 0; e < _n / 4; ++e)
+	{
+		MP<_n, O> poly(quads[e]);
+		poly += quads[e + 1];
+		for (size_t j = 0; j < 4; ++j)
+			poly += MM<_n>(Env::Rand() % _n);
+		system.Insert(poly);
+	}
+	ElimLin<_n, O> el;
+	Bench(Name("ElimLin", _n, "Quad"), [&]()
+	{
+		s = system;
+		el.Process(s);
+		Keep(s.Size());
+	});
+}
+
+template<size_t _n> void benchHybrid()
+{
+	typedef MOGrevlex<_n> O;
+	Env::Seed(_n + 13);
+	MI<_n, O> system;
+	RandQuadSystem(system, _n);
+	Pool pool;
+	Hybrid<_n, O> hybrid(pool);
+	for (size_t k = 0; k <= 4; k += 2)
+	{
+		char suffix[16];
+		::snprintf(suffix, sizeof(suffix), "Guess%zu", k);
+		hybrid.SetGuess(k);
+		Bench(Name("Hybrid", _n, suffix), [&]()
+		{
+			Keep(hybrid.Process(system, [](const WW<_n>&) {}));
+		});
+	}
+}
+
+template<size_t _n> void benchFGLM()
+{
+	typedef MOGrevlex<_n> O;
+	typedef MOLex<_n> O2;
+	Env::Seed(_n + 17);
+	MI<_n, O> system, gb;
+	RandQuadSystem(system, _n / 2);
+	Buchb<_n, O> bb;
+	bb.Init(), bb.Update(system), bb.Process(), bb.Done(gb);
+	// смена порядка
+	FGLM<_n, O> fglm;
+	MI<_n, O2> lex;
+	Bench(Name("FGLM", _n, "Lex"), [&]()
+	{
+		fglm.Process(gb, lex);
+		Keep(lex.Size());
+	});
+	// базис в целевом порядке непосредственно
+	MI<_n, O2> system2;
+	system2 = system;
+	Buchb<_n, O2> bb2;
+	Bench(Name("Buchb", _n, "Lex"), [&]()
+	{
+		bb2.Init(), bb2.Update(system2), bb2.Process(), bb2.Done(lex);
+		Keep(lex.Size());
+	});
+}
+
+template<size_t _n> void benchSubst()
+{
+	typedef MOGrevlex<2 * _n> O;
+	Env::Seed(_n + 4);
+	VSubst<_n> s;
+	s.Rand();
+	MI<2 * _n, O> system, gb;
+	s.To(system);
+	Buchb<2 * _n, O> bb;
+	Bench(Name("Buchb", _n, "VSubst"), [&]()
+	{
+		bb.Init();
+		bb.Update(system);
+		bb.Process();
+		bb.Done(gb);
+		Keep(gb.Size());
+	});
+}
+
+/*
+*******************************************************************************
+Замеры Func
+*******************************************************************************
+*/
+
+template<size_t _n> void benchFunc()
+{
+	Env::Seed(_n + 5);
+	BFunc<_n> bf;
+	bf.Rand();
+	Func<_n, int> zf;
+	Bench(Name("BFunc", _n, "FWHT"), [&]() { bf.FWHT(zf); Keep(zf.Get(1)); });
+	Bench(Name("BFunc", _n, "Nl"), [&]() { Keep(bf.Nl()); });
+}
+
+template<size_t _n> void benchVSubst()
+{
+	Env::Seed(_n + 6);
+	VSubst<_n> s;
+	s.Rand();
+	Bench(Name("VSubst", _n, "Nl"), [&]() { Keep(s.Nl()); });
+	Bench(Name("VSubst", _n, "Dc"), [&]() { Keep(s.Dc(0) + s.Dc(1)); });
+}
+
+/*
+*******************************************************************************
+Ввод-вывод результатов
+*******************************************************************************
+*/
+
+// записать результаты в JSON
+static bool WriteJSON(const char* path)
+{
+	FILE* fp = ::fopen(path, "w");
+	if (!fp)
+		return false;
+	::fprintf(fp, "{\n  \"version\": \"%s\",\n  \"benchmarks\": [\n",
+		Env::Version());
+	for (size_t i = 0; i < _results.size(); ++i)
+		::fprintf(fp, "    {\"name\": \"%s\", \"iters\": %zu, \"ns\": %.3f}%s\n",
+			_results[i].name.c_str(), _results[i].iters, _results[i].ns,
+			i + 1 < _results.size() ? "," : "");
+	::fprintf(fp, "  ]\n}\n");
+	return ::fclose(fp) == 0;
+}
+
+// прочитать результаты из JSON (в формате WriteJSON())
+static bool ReadJSON(const char* path, vector<Result>& results)
+{
+	FILE* fp = ::fopen(path, "rb");
+	if (!fp)
+		return false;
+	string text;
+	char buf[4096];
+	for (size_t count; (count = ::fread(buf, 1, sizeof(buf), fp)) > 0;)
+		text.append(buf, count);
+	::fclose(fp);
+	// цикл по записям
+	results.clear();
+	for (size_t pos = 0; (pos = text.find("\"name\"", pos)) != string::npos;)
+	{
+		Result res = { "", 0, 0 };
+		size_t begin = text.find('"', text.find(':', pos)) + 1;
+		size_t end = text.find('"', begin);
+		size_t ns = text.find("\"ns\"", end);
+		if (begin == 0 || end == string::npos || ns == string::npos)
+			return false;
+		res.name = text.substr(begin, end - begin);
+		res.ns = ::strtod(text.c_str() + text.find(':', ns) + 1, 0);
+		results.push_back(res);
+		pos = end;
+	}
+	return true;
+}
+
+// сравнить результаты с базовыми
+static size_t Compare(const vector<Result>& base, double tol)
+{
+	size_t regressions = 0;
+	for (size_t i = 0; i < _results.size(); ++i)
+		for (size_t j = 0; j < base.size(); ++j)
+			if (base[j].name == _results[i].name && base[j].ns > 0)
+			{
+				double ratio = _results[i].ns / base[j].ns;
+				bool regression = ratio > 1 + tol;
+				regressions += regression;
+				Env::Print("%-40s %8.3fx%s\n", _results[i].name.c_str(),
+					ratio, regression ? "  REGRESSION" : "");
+				break;
+			}
+	return regressions;
+}
+
+/*
+*******************************************************************************
+main
+*******************************************************************************
+*/
+
+int main(int argc, char* argv[])
+{
+	const char* out = 0;
+	const char* base = 0;
+	double tol = 0.1;
+	// разбор командной строки
+	for (int i = 1; i < argc; ++i)
+		if (i + 1 < argc && ::strcmp(argv[i], "-o") == 0)
+			out = argv[++i];
+		else if (i + 1 < argc && ::strcmp(argv[i], "-b") == 0)
+			base = argv[++i];
+		else if (i + 1 < argc && ::strcmp(argv[i], "-t") == 0)
+			tol = ::strtod(argv[++i], 0);
+		else if (i + 1 < argc && ::strcmp(argv[i], "-r") == 0)
+			_reps = std::max<size_t>(1, ::strtoul(argv[++i], 0, 10));
+		else if (i + 1 < argc && ::strcmp(argv[i], "-f") == 0)
+			_filter = argv[++i];
+		else
+		{
+			Env::Print("Usage: benchgf2 [-o out.json] [-b base.json] "
+				"[-t tol] [-r reps] [-f filter]\n");
+			return 2;
+		}
+	Env::Print("gf2/bench [gf2 version %s]\n", Env::Version());
+	Env::SetTrace(false);
+	// замеры
+	benchWW<64>(), benchWW<256>(), benchWW<1024>(), benchWW<4096>();
+	benchZZ<256>(), benchZZ<1024>();
+	benchMP<64>(), benchMP<256>();
+	benchMT<64>(), benchMT<256>();
+	benchMI<10>(), benchMI<12>();
+	benchBatch<10>();
+	benchExhaust<16>();
+	benchMat();
+	benchSMat();
+	benchXL<16>();
+	benchElimLin<64>();
+	benchHybrid<10>();
+	benchFGLM<10>();
+	benchSubst<4>(), benchSubst<5>();
+	benchFunc<12>(), benchFunc<16>();
+	benchVSubst<6>(), benchVSubst<8>();
+	// вывод
+	if (out && !WriteJSON(out))
+	{
+		Env::Print("Error writing %s\n", out);
+		return 2;
+	}
+	// сравнение
+	if (base)
+	{
+		vector<Result> results;
+		if (!ReadJSON(base, results))
+		{
+			Env::Print("Error reading %s\n", base);
+			return 2;
+		}
+		size_t regressions = Compare(results, tol);
+		Env::Print("%zu regression(s)\n", regressions);
+		return regressions ? 1 : 0;
+	}
+	return 0;
+}
@@ -0,0 +1,175 @@
+/*
+*******************************************************************************
+\file batch.h
+\brief Batch computation of Groebner bases
+\project GF2 [algebra over GF(2)]
+\created 2026.10.16
+\version 2026.10.16
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file batch.h
+\brief Пакетное построение базисов Гребнера
+
+Модуль содержит описание и реализацию класса BuchbBatch, который строит
+базисы Гребнера многих независимых систем параллельно.
+*******************************************************************************
+*/
+
+#ifndef __GF2_BATCH
+#define __GF2_BATCH
+
+#include "gf2/buchb.h"
+#include "gf2/pool.h"
+#include <vector>
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс BuchbBatch
+
+Построение редуцированных базисов Гребнера пакета независимых систем
+на исполнителях пула потоков Pool.
+
+За каждым исполнителем закреплены экземпляр Buchb и рабочие системы,
+которые повторно используются от системы к системе, а не создаются
+заново. Экземпляры Buchb можно настроить заранее (см. GetEngine()).
+Системы, переданные f, возвращаются в запас и затем достаются
+исполнителям в качестве рабочих: Buchb::Done() записывает базис поверх
+их многочленов и мономов, не выделяя память заново. Массивы ожидающих
+результатов сохраняют емкость от пакета к пакету.
+
+Результаты передаются функции обратного вызова f(index, gb), где index --
+номер системы в пакете, gb -- ее редуцированный базис. Вызовы f
+последовательны (выполняются под блокировкой), поэтому f не обязана быть
+потокобезопасной. Функция f может забрать gb (например, через Swap()).
+Результаты передаются либо в порядке номеров систем (ordered == true),
+либо по мере готовности. В первом случае готовые результаты, которые
+опережают еще не построенные, накапливаются.
+
+\code
+	Pool pool;
+	BuchbBatch<n, O> batch(pool);
+	batch.Process(systems.data(), systems.size(),
+		[&](size_t index, MI<n, O>& gb) { ... });
+\endcode
+*******************************************************************************
+*/
+
+template<size_t _n, class _O> class BuchbBatch
+{
+protected:
+	typedef MI<_n, _O> _I;
+	//! Данные исполнителя
+	struct _Worker
+	{
+		Buchb<_n, _O> bb; //< алгоритм Бухбергера
+		_I order; //< пустая система с порядком очередной системы
+		_I gb; //< базис очередной системы
+	};
+	Pool& _pool; // пул потоков
+	std::vector<_Worker> _workers; // исполнители
+	std::mutex _lock; // блокировка вызовов f
+	std::vector<_I> _ready; // результаты, ожидающие передачи
+	std::vector<bool> _isReady; // признаки готовности результатов
+	std::vector<_I> _spare; // запас систем для исполнителей
+	size_t _next; // номер следующего передаваемого результата
+
+	//! Возврат в запас
+	/*! Система gb, переданная f, возвращается в запас (если запас
+		не заполнен) и очищается. */
+	void _Recycle(_I& gb)
+	{
+		if (_spare.size() < _workers.size())
+		{
+			_spare.emplace_back(gb.GetOrder());
+			_spare.back().Swap(gb);
+		}
+		gb.SetEmpty();
+	}
+
+	//! Выдача из запаса
+	/*! Пустая рабочая система gb заменяется системой из запаса. */
+	void _Reuse(_I& gb)
+	{
+		if (_spare.empty())
+			return;
+		gb.SetOrder(_spare.back().GetOrder());
+		gb.Swap(_spare.back());
+		_spare.pop_back();
+	}
+
+public:
+	//! Экземпляр Buchb исполнителя worker
+	Buchb<_n, _O>& GetEngine(size_t worker)
+	{
+		assert(worker < _workers.size());
+		return _workers[worker].bb;
+	}
+
+	//! Обработка пакета
+	/*! Строятся редуцированные базисы Гребнера систем systems[0],...,
+		systems[count - 1]. Каждый базис передается функции f(index, gb).
+		При ordered == true базисы передаются в порядке номеров систем,
+		иначе -- по мере готовности. Базис строится в порядке системы. */
+	template<class _F>
+	void Process(const _I* systems, size_t count, _F&& f, bool ordered = true)
+	{
+		if (ordered)
+		{
+			if (_ready.size() < count)
+				_ready.resize(count);
+			_isReady.assign(count, false);
+			_next = 0;
+		}
+		_pool.Run(count, [&](size_t worker, size_t index)
+		{
+			_Worker& w = _workers[worker];
+			w.order.SetOrder(systems[index].GetOrder());
+			w.bb.Init(w.order);
+			w.bb.Update(systems[index]);
+			w.bb.Process();
+			w.bb.Done(w.gb);
+			std::lock_guard<std::mutex> guard(_lock);
+			if (!ordered)
+			{
+				f(index, w.gb);
+				return;
+			}
+			_ready[index].SetOrder(w.gb.GetOrder());
+			_ready[index].Swap(w.gb);
+			_Reuse(w.gb);
+			_isReady[index] = true;
+			for (; _next < count && _isReady[_next]; ++_next)
+			{
+				f(_next, _ready[_next]);
+				_Recycle(_ready[_next]);
+			}
+		});
+	}
+
+	//! Обработка пакета
+	/*! Строятся редуцированные базисы Гребнера систем из systems. */
+	template<class _F>
+	void Process(const std::vector<_I>& systems, _F&& f, bool ordered = true)
+	{
+		Process(systems.data(), systems.size(), f, ordered);
+	}
+
+	//! Конструктор
+	/*! Пакеты обрабатываются на исполнителях пула pool. */
+	explicit BuchbBatch(Pool& pool) : _pool(pool), _workers(pool.Size()),
+		_next(0)
+	{
+		_spare.reserve(_workers.size());
+	}
+};
+
+} // namespace GF2
+
+#endif // __GF2_BATCH
@@ -4,7 +4,7 @@
 \brief Buchberger's algorithm
 \project GF2 [algebra over GF(2)]
 \created 2006.01.01
-\version 2024.05.08
+\version 2026.10.16
 \license This program is released under the MIT License. See Copyright Notices 
 in GF2/info.h.
 *******************************************************************************
@@ -27,8 +27,16 @@ in GF2/info.h.
 #define __GF2_BUCHB
 
 #include "gf2/env.h"
+#include "gf2/io.h"
 #include "gf2/mi.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
 #include <map>
+#include <unordered_map>
+#include <string>
+#include <vector>
 
 namespace GF2 {
 
@@ -42,8 +50,10 @@ namespace GF2 {
 x_i^2-x_i (номер i сохраняется в var1), либо явный многочлен 
 (сохраняется в iter1, при этом var1 полагается равным SIZE_MAX).
 Вторым многочленом пары (поле iter2) всегда является явный 
-многочлен. Старшие мономы многочленов дублируются в полях lm1
-и lm2.
+многочлен. Старшие мономы многочленов не копируются, а определяются 
+по итераторам (методы LM1(), LM2()). Это допустимо, поскольку старшие 
+мономы многочленов базиса и резерва не меняются, пока на них ссылаются 
+необработанные пары.
 
 При работе алгоритма Бухбергера второй элемент пары добавляется 
 в базис Гребнера всегда позже первого.
@@ -70,7 +80,8 @@ x_i^2-x_i (номер i сохраняется в var1), либо явный м
 	{...}
 \endcode
 Порядок < влияет на последовательность выбора пар в алгоритме Бухбергера: 
-если cp1 < cp2, то cp1 обязательно будет обработана прежде cp2.
+если cp1 < cp2 и пары имеют одинаковый ключ очереди (см. CPQueue), то cp1 
+обязательно будет обработана прежде cp2.
 ******************************************************************************
 */
 
@@ -86,23 +97,36 @@ public:
 	/*! Информация о первом многочлене пары.*/
 	struct
 	{
-		const size_t var1; //< номер переменной, задающей уравнение поля
-		const iterator iter1; //< позиция явного многочлена
-		const MM<_n> lm1; //< старший моном многочлена
+		size_t var1; //< номер переменной, задающей уравнение поля
+		iterator iter1; //< позиция явного многочлена
 	};
 	//! Второй многочлен
 	/*! Информация о втором многочлене пары.*/
 	struct
 	{
-		const iterator iter2; //< позиция явного многочлена
-		const MM<_n> lm2; //< старший моном многочлена
+		iterator iter2; //< позиция явного многочлена
 	};
 	//! НОК старших мономов
 	/*! НОК старших мономов пары многочленов
 		\remark При использовании уравнения поля (first.var != SIZE_MAX)
 		НОК неявно домножается на переменную c номером first.var
 		в методах сравнения и проверки делимости. */
-	const MM<_n> lcm;
+	MM<_n> lcm;
+
+// старшие мономы
+public:
+	//! Старший моном первого многочлена
+	/*! Для уравнения поля x_i^2 - x_i возвращается x_i. */
+	MM<_n> LM1() const
+	{
+		return var1 == SIZE_MAX ? iter1->LM() : MM<_n>(var1);
+	}
+
+	//! Старший моном второго многочлена
+	const MM<_n>& LM2() const
+	{
+		return iter2->LM();
+	}
 
 // S-многочлен
 public:
@@ -159,14 +183,14 @@ public:
 	bool IsRelPrime() const
 	{	
 		return var1 != SIZE_MAX ? 
-			lm2.Test(var1) == 0 : GCD(lm1, lm2).IsAllZero();
+			LM2().Test(var1) == 0 : LM2().IsRelPrime(iter1->LM());
 	}
 
 	//! R-пара?
 	/*! Возвращается признак того, что второй старший моном делит первый. */
 	bool IsRPair() const
 	{
-		return lm2 | lm1;
+		return LM2() | LM1();
 	}
 
 	//! Меньше?
@@ -184,9 +208,9 @@ public:
 		if (var1 != SIZE_MAX)
 			Env::Print("x_%zu^2-x_%zu", var1, var1);
 		else
-			std::cout << lm1;
+			std::cout << LM1();
 		Env::Print(", ");
-		std::cout << lm2;
+		std::cout << LM2();
 		Env::Print("]\n");
 	}
 
@@ -195,27 +219,300 @@ public:
 	//! Конструктор по двум итераторам и атрибутам
 	/*! Создается пара многочленов (*i1, *i2). */
 	CritPair(iterator i1, iterator i2) :
-		var1(SIZE_MAX), iter1(i1), lm1(i1->LM()), iter2(i2), 
-		lm2(i2->LM()), lcm(LCM(lm1, lm2))
+		var1(SIZE_MAX), iter1(i1), iter2(i2), lcm(LCM(i1->LM(), i2->LM()))
 	{
 	}
 
 	//! Конструктор по уравнению поля и итератору с атрибутом
 	/*! Создается пара многочленов (x_i^2-x_i, *i2). */
 	CritPair(size_t i, iterator i2) :
-		var1(i), iter1(), lm1(i), iter2(i2), lm2(i2->LM()),
-		lcm(LCM(lm1, lm2))
+		var1(i), iter1(), iter2(i2), lcm(LCM(MM<_n>(i), i2->LM()))
 	{
 	}
 
 	//! Конструктор копирования
 	/*! Создается копия пары cpRight. */
-	CritPair(const CritPair& cpRight) : 
-		var1(cpRight.var1), iter1(cpRight.iter1), lm1(cpRight.lm1), 
-		iter2(cpRight.iter2), lm2(cpRight.lm2), 
-		lcm(cpRight.lcm)
+	CritPair(const CritPair& cpRight) = default;
+
+	//! Присваивание
+	/*! Паре присваивается пара cpRight. 
+		\remark Присваивание требуется при хранении пар в очереди CPQueue. */
+	CritPair& operator=(const CritPair& cpRight) = default;
+};
+
+/*!
+*******************************************************************************
+Стратегии выбора критических пар
+
+-	CP_SEL_NORMAL: нормальная стратегия, пары выбираются в порядке 
+	возрастания НОК старших мономов (CritPair::operator<());
+-	CP_SEL_SUGAR: стратегия сахара [Giovini A. et al. "One sugar cube, 
+	please" or selection strategies in the Buchberger algorithm, ISSAC'91],
+	сначала выбираются пары с наименьшим сахаром, при равенстве сахара -- 
+	как в нормальной стратегии;
+-	CP_SEL_DEG: сначала выбираются пары с наименьшей степенью НОК старших 
+	мономов, при равенстве степеней -- как в нормальной стратегии.
+*******************************************************************************
+*/
+
+enum CPSel
+{
+	CP_SEL_NORMAL = 0,
+	CP_SEL_SUGAR = 1,
+	CP_SEL_DEG = 2,
+};
+
+/*!
+*******************************************************************************
+Класс CPQueue
+
+Очередь критических пар с приоритетами. 
+
+Каждой паре при вставке назначается ключ (целое число без знака, которое 
+определяется стратегией выбора, например, сахар или степень НОК) и 
+порядковый номер вставки. Первой выбирается пара с наименьшим ключом, 
+при равенстве ключей -- наименьшая в смысле _CP::operator<(), а при 
+равенстве и в этом смысле -- вставленная раньше. Поэтому при нулевых ключах 
+пары выбираются в том же порядке, что и при хранении в отсортированном 
+списке со слиянием новых пар в конец групп равных.
+
+Пары хранятся в ячейках массива, а двоичная куча содержит номера ячеек. 
+Освободившиеся ячейки используются повторно. Номера ячеек можно использовать
+для внешней индексации пар (см. Push(), Remove()).
+
+Метод PopMinDeg() извлекает сразу все пары, НОК которых имеет наименьшую 
+степень, независимо от ключей (пары должны иметь член lcm -- моном НОК).
+*******************************************************************************
+*/
+
+template<class _CP> class CPQueue
+{
+	struct _Slot
+	{
+		_CP cp; //< пара
+		u32 key; //< ключ
+		u64 seq; //< порядковый номер вставки
+		bool live; //< пара не удалена
+	};
+	std::vector<_Slot> _slots; //< ячейки
+	std::vector<size_t> _free; //< свободные ячейки
+	std::vector<size_t> _heap; //< куча номеров ячеек
+	size_t _live; //< число неудаленных пар
+	u64 _seq; //< счетчик вставок
+
+	//! Сравнение ячеек
+	/*! Проверяется, что пара в ячейке left должна быть выбрана позже пары 
+		в ячейке right (min-куча строится на операции "больше"). */
+	struct _Greater
+	{
+		const std::vector<_Slot>* slots;
+		bool operator()(size_t left, size_t right) const
+		{
+			const _Slot& l = (*slots)[left];
+			const _Slot& r = (*slots)[right];
+			if (l.key != r.key)
+				return l.key > r.key;
+			if (r.cp < l.cp)
+				return true;
+			if (l.cp < r.cp)
+				return false;
+			return l.seq > r.seq;
+		}
+	};
+	_Greater _Cmp() const
 	{
+		return _Greater{&_slots};
 	}
+
+	//! Уборка
+	/*! Удаленные пары убираются из вершины кучи. Если удаленных пар 
+		в куче становится больше, чем неудаленных, то куча перестраивается. */
+	void _Skip()
+	{
+		if (_heap.size() > 2 * _live + 16)
+		{
+			auto iter = _heap.begin();
+			for (auto iterHeap = _heap.begin(); iterHeap != _heap.end(); 
+				++iterHeap)
+				if (_slots[*iterHeap].live)
+					*iter++ = *iterHeap;
+				else
+					_free.push_back(*iterHeap);
+			_heap.erase(iter, _heap.end());
+			std::make_heap(_heap.begin(), _heap.end(), _Cmp());
+		}
+		while (!_heap.empty() && !_slots[_heap.front()].live)
+		{
+			std::pop_heap(_heap.begin(), _heap.end(), _Cmp());
+			_free.push_back(_heap.back()), _heap.pop_back();
+		}
+	}
+
+public:
+	//! Число пар
+	size_t Size() const
+	{
+		return _live;
+	}
+
+	//! Пустая очередь?
+	bool IsEmpty() const
+	{
+		return _live == 0;
+	}
+
+	//! Очистка
+	void Clear()
+	{
+		_slots.clear(), _free.clear(), _heap.clear();
+		_live = 0, _seq = 0;
+	}
+
+	//! Вставка
+	/*! В очередь вставляется пара cp с ключом key. 
+		\return Номер ячейки, в которой размещена пара. Номер остается 
+		действительным, пока пара не выбрана и не удалена. */
+	size_t Push(const _CP& cp, u32 key = 0)
+	{
+		size_t slot;
+		if (_free.empty())
+			slot = _slots.size(), 
+			_slots.push_back(_Slot{cp, key, _seq++, true});
+		else
+		{
+			slot = _free.back(), _free.pop_back();
+			_slots[slot].cp = cp;
+			_slots[slot].key = key, _slots[slot].seq = _seq++;
+			_slots[slot].live = true;
+		}
+		_heap.push_back(slot), ++_live;
+		std::push_heap(_heap.begin(), _heap.end(), _Cmp());
+		return slot;
+	}
+
+	//! Пара в ячейке
+	/*! Возвращается пара, размещенная в ячейке slot. */
+	const _CP& At(size_t slot) const
+	{
+		assert(slot < _slots.size() && _slots[slot].live);
+		return _slots[slot].cp;
+	}
+
+	//! Первая пара
+	/*! Возвращается пара, которая будет выбрана первой. 
+		\pre !IsEmpty(). */
+	const _CP& Top() const
+	{
+		assert(!IsEmpty());
+		return _slots[_heap.front()].cp;
+	}
+
+	//! Ячейка первой пары
+	/*! \pre !IsEmpty(). */
+	size_t TopSlot() const
+	{
+		assert(!IsEmpty());
+		return _heap.front();
+	}
+
+	//! Ключ первой пары
+	/*! \pre !IsEmpty(). */
+	u32 TopKey() const
+	{
+		assert(!IsEmpty());
+		return _slots[_heap.front()].key;
+	}
+
+	//! Выбор
+	/*! Из очереди извлекается первая пара. 
+		\pre !IsEmpty(). */
+	_CP Pop()
+	{
+		assert(!IsEmpty());
+		std::pop_heap(_heap.begin(), _heap.end(), _Cmp());
+		size_t slot = _heap.back();
+		_heap.pop_back(), _free.push_back(slot);
+		_slots[slot].live = false, --_live;
+		_Skip();
+		return _slots[slot].cp;
+	}
+
+	//! Удаление
+	/*! Из очереди удаляется пара в ячейке slot. 
+		\remark Пара остается в куче с пометкой об удалении и пропускается 
+		при выборе. Удаление выполняется за время O(1) (амортизированное). */
+	void Remove(size_t slot)
+	{
+		assert(slot < _slots.size() && _slots[slot].live);
+		_slots[slot].live = false, --_live;
+		_Skip();
+	}
+
+	//! Выбор пар наименьшей степени
+	/*! Из очереди извлекаются все пары, НОК которых имеет наименьшую 
+		степень (независимо от ключей). Пары добавляются в конец cps 
+		в порядке выбора. 
+		\return Число извлеченных пар. */
+	size_t PopMinDeg(std::vector<_CP>& cps)
+	{
+		// наименьшая степень
+		int deg = INT_MAX;
+		for (auto iter = _heap.begin(); iter != _heap.end(); ++iter)
+			if (_slots[*iter].live)
+				deg = std::min(deg, _slots[*iter].cp.lcm.Deg());
+		// извлечение
+		std::vector<size_t> order;
+		auto pos = _heap.begin();
+		for (auto iter = _heap.begin(); iter != _heap.end(); ++iter)
+			if (!_slots[*iter].live)
+				_free.push_back(*iter);
+			else if (_slots[*iter].cp.lcm.Deg() == deg)
+				order.push_back(*iter);
+			else
+				*pos++ = *iter;
+		_heap.erase(pos, _heap.end());
+		std::make_heap(_heap.begin(), _heap.end(), _Cmp());
+		// в порядке выбора
+		std::sort(order.begin(), order.end(), 
+			[this](size_t left, size_t right) 
+			{ return _Cmp()(right, left); });
+		for (auto iter = order.begin(); iter != order.end(); ++iter)
+		{
+			cps.push_back(_slots[*iter].cp);
+			_slots[*iter].live = false, --_live;
+			_free.push_back(*iter);
+		}
+		return order.size();
+	}
+
+	//! Пересчет ключей
+	/*! Ключи всех пар cp пересчитываются как key(cp). */
+	template<class _Key> void Rekey(_Key key)
+	{
+		for (auto iter = _heap.begin(); iter != _heap.end(); ++iter)
+			_slots[*iter].key = key(static_cast<const _CP&>(_slots[*iter].cp));
+		std::make_heap(_heap.begin(), _heap.end(), _Cmp());
+		_Skip();
+	}
+
+	//! Обход в порядке выбора
+	/*! Для всех пар cp в порядке их выбора вызывается f(cp, key). */
+	template<class _F> void ForEach(_F f) const
+	{
+		std::vector<size_t> order;
+		order.reserve(_live);
+		for (auto iter = _heap.begin(); iter != _heap.end(); ++iter)
+			if (_slots[*iter].live)
+				order.push_back(*iter);
+		std::sort(order.begin(), order.end(), 
+			[this](size_t left, size_t right) 
+			{ return _Cmp()(right, left); });
+		for (auto iter = order.begin(); iter != order.end(); ++iter)
+			f(static_cast<const _CP&>(_slots[*iter].cp), _slots[*iter].key);
+	}
+
+	//! Конструктор
+	CPQueue() : _live(0), _seq(0) {}
 };
 
 /*!
@@ -267,7 +564,41 @@ S-многочленов. При работе алгоритма Бухберг
 
 Метод ValidatePre() аналогичен Validate(). Отличие только в том, что
 ValidatePre() выполняется до приведения S-многочлена по модулю текущей 
-системы, а Validate() -- уже после приведения.
+системы, а Validate() -- уже после приведения. Вызов Stop() из этих 
+методов прекращает вычисления (например, когда в базис попала 1): 
+Update() и Process() завершаются, не обрабатывая оставшиеся многочлены 
+и пары. Признак прекращения сбрасывается в Init().
+
+Состояние вычислений (базис, резерв, необработанные критические пары, 
+статистику) можно сохранить в файле-снимке методом SaveCheckpoint() 
+и восстановить методом LoadCheckpoint(). Итераторы критических пар 
+сохраняются как номера многочленов в списках базиса и резерва. Списки 
+поддерживаются нормализованными, поэтому после загрузки (которая 
+нормализует системы) номера указывают на те же многочлены. Снимки 
+можно создавать и автоматически во время работы Process(): через каждые 
+pairs обработанных пар или secs секунд (см. SetCheckpoint()).
+Продолжение вычислений со снимка приводит к тому же базису, что и 
+вычисления без перерыва.
+
+Необработанные критические пары хранятся в очереди с приоритетами CPQueue.
+Порядок выбора пар определяется стратегией (см. SetSelection()):
+-	CP_SEL_NORMAL --- нормальная стратегия (по возрастанию lcm);
+-	CP_SEL_SUGAR --- сначала пары с минимальным сахаром [GMNRT91];
+-	CP_SEL_DEG --- сначала пары с минимальной степенью lcm.
+Редуцированный базис Гребнера не зависит от стратегии, меняется только 
+объем промежуточных вычислений.
+
+При обновлении списка пар (критерии A, B, C из [GMI87]) НОК пар хранятся 
+в деревьях делителей MMTree. Кандидаты на исключение (пары, НОК которых 
+делятся на старший моном нового многочлена, делят или делятся на НОК новой 
+пары) находятся обходом дерева, который затрагивает только кандидатов 
+и префиксы их НОК, а не все пары. Кандидаты просматриваются по возрастанию 
+номеров, поэтому порядок принятия решений и результат совпадают с полным 
+перебором.
+
+[GMNRT91] Giovini A., Mora T., Niesi G., Robbiano L., Traverso C. 
+        "One sugar cube, please" or selection strategies in the Buchberger
+        algorithm, Proc. ISSAC'91, 49-54, 1991.
 *******************************************************************************
 */
 
@@ -288,8 +619,16 @@ protected:
 	typedef std::list<_CP> _CPs;
 	_I _basis; // многочлены базиса Гребнера
 	_I _reserve; // многочлены, исключенные r-критерием
-	_CPs _pairs; // критические пары, которые надо обработать
-	_CPs _pairs_processed; // обработанные критические пары
+	CPQueue<_CP> _pairs; // критические пары, которые надо обработать
+	MMTree<_n> _lcms; // НОК пар _pairs (по номерам ячеек)
+	MMTree<_n> _newlcms; // НОК новых пар в _Update()
+	std::vector<size_t> _found; // позиции, найденные в индексах
+	_CPs _pairs_processed; // последние обработанные критические пары
+	size_t _history; // число сохраняемых обработанных пар
+	CPSel _sel; // стратегия выбора пар
+	Pool* _pool; // пул потоков для самоприведения в Update()
+	bool _stopped; // вычисления прекращены (см. Stop())
+	std::unordered_map<const _P*, u32> _sugar; // сахар многочленов
 	struct
 	{
 		size_t pairs_processed; // обработано критических пар
@@ -301,8 +640,88 @@ protected:
 		size_t buch_criterion; // число пар, исключенных I критерием Бухбергера
 		size_t r_criterion; // число многочленов, переведенных в резерв
 	} _stat; // статистика
+	struct
+	{
+		std::string path; // имя файла
+		size_t pairs; // период (в обработанных парах)
+		u32 secs; // период (в секундах)
+		size_t last_pairs; // число обработанных пар в последнем снимке
+		u32 last_secs; // время последнего снимка
+	} _checkpoint; // автоматические снимки
 // вычисления
 protected:
+	//! Сахар многочлена
+	/*! Возвращается сахар многочлена базиса или резерва в позиции pos. 
+		Для многочленов, сахар которых не задан (например, загруженных 
+		в Init(gb)), сахаром считается степень. */
+	u32 _PolySugar(_Iterator pos) const
+	{
+		auto iter = _sugar.find(&*pos);
+		return iter != _sugar.end() ? iter->second : u32(pos->Deg());
+	}
+
+	//! Сахар пары
+	/*! Сахар пары (f1, f2) -- максимум из sugar(f1) + deg(lcm / LM(f1)) и 
+		sugar(f2) + deg(lcm / LM(f2)). Сахар уравнения поля x_i^2 - x_i 
+		равняется 2, и для пары (x_i^2 - x_i, f) получаем sugar(f) + 1. */
+	u32 _PairSugar(const _CP& cp) const
+	{
+		u32 deg = u32(cp.lcm.Deg());
+		u32 sugar2 = _PolySugar(cp.iter2) + deg - u32(cp.LM2().Deg());
+		if (cp.var1 != SIZE_MAX)
+			return std::max(sugar2 + 1, u32(2));
+		return std::max(sugar2, 
+			_PolySugar(cp.iter1) + deg - u32(cp.iter1->LM().Deg()));
+	}
+
+	//! Ключ пары
+	/*! Определяется ключ пары cp в очереди в соответствии со стратегией 
+		выбора. */
+	u32 _Key(const _CP& cp) const
+	{
+		if (_sel == CP_SEL_SUGAR)
+			return _PairSugar(cp);
+		if (_sel == CP_SEL_DEG)
+			return u32(cp.lcm.Deg());
+		return 0;
+	}
+
+	//! Добавление пары
+	/*! Пара cp с ключом key добавляется в очередь и в индекс НОК. */
+	void _PushPair(const _CP& cp, u32 key)
+	{
+		_lcms.Insert(_pairs.Push(cp, key), cp.lcm);
+	}
+
+	//! Добавление пар
+	/*! Пары списка cps добавляются в очередь. Список очищается. */
+	void _Push(_CPs& cps)
+	{
+		for (auto iter = cps.begin(); iter != cps.end(); ++iter)
+			_PushPair(*iter, _Key(*iter));
+		cps.clear();
+	}
+
+	//! Выбор пары
+	/*! Из очереди извлекается первая пара. */
+	_CP _PopPair()
+	{
+		_lcms.Erase(_pairs.TopSlot(), _pairs.Top().lcm);
+		return _pairs.Pop();
+	}
+
+	//! Делимость НОК
+	/*! Проверяется, что m делит LCM(m1, m2). Временный моном 
+		LCM(m1, m2) не создается. */
+	static bool _DividesLCM(const MM<_n>& m, const MM<_n>& m1, 
+		const MM<_n>& m2)
+	{
+		for (size_t pos = 0; pos < m.WordSize(); ++pos)
+			if (m.GetWord(pos) & ~(m1.GetWord(pos) | m2.GetWord(pos)))
+				return false;
+		return true;
+	}
+
 	//! Внутреннее обновление
 	/*! Список критических пар обновляется с учетом пар,
 		которые включают многочлен системы в позиции posPoly. */
@@ -311,12 +730,15 @@ protected:
 		// критерий A:
 		// если LM(poly) | [LM(f_i), LM(f_j)] и (f_i, f_j) не является r-парой,
 		// то (f_i, f_j) можно исключить
-		auto posPair = _pairs.begin();
-		for (; posPair != _pairs.end();)
-			if ((posPoly->LM() | posPair->lcm) && !posPair->IsRPair())
-				posPair = _pairs.erase(posPair), _stat.a_criterion++;
-			else 
-				++posPair;
+		// (кандидаты -- кратные LM(poly) в индексе НОК)
+		_lcms.Multiples(posPoly->LM(), _found);
+		for (size_t slot : _found)
+			if (!_pairs.At(slot).IsRPair())
+			{
+				_lcms.Erase(slot, _pairs.At(slot).lcm);
+				_pairs.Remove(slot);
+				_stat.a_criterion++;
+			}
 
 		// формируем r-пары (f_i, poly), где LM(poly) | LM(f_i)
 		// удаляем многочлены f_i
@@ -347,17 +769,37 @@ protected:
 			// упрощаем *posBasis
 			else posBasis->Mod(*posPoly), ++posBasis;
 		}
-		// добавляем r-пары в список критических пар
+		// добавляем r-пары в очередь критических пар
 		newpairs.sort();
-		_pairs.merge(newpairs);
+		_Push(newpairs);
+
+		// новые пары хранятся в массиве в порядке добавления, 
+		// их НОК -- в индексе _newlcms по номерам в массиве;
+		// исключенные пары удаляются только из индекса
+		// (у всех новых пар второй многочлен -- poly, старшие мономы 
+		// первых многочленов копируются в lms для быстрого доступа)
+		const MM<_n>& lm = posPoly->LM();
+		std::vector<_CP> cps;
+		std::vector<MM<_n>> lms;
+		_newlcms.Clear();
+		auto add = [&](const _CP& cp) 
+		{
+			_newlcms.Insert(cps.size(), cp.lcm);
+			cps.push_back(cp), lms.push_back(cp.LM1());
+		};
+		auto relprime = [&](size_t pos) 
+		{
+			return cps[pos].var1 != SIZE_MAX ? 
+				!lm.Test(cps[pos].var1) : lm.IsRelPrime(lms[pos]);
+		};
 
 		// добавляем пары (x_i^2 - x_i, poly)  
 		// с учетом первого критерия Бухбергера рассматриваем только
 		// такие i, что LM(poly) содержит x_i
-		for (size_t var = 0; var < _n; var++)
+		for (size_t var = _n; var--;)
 			// есть зацепление?
-			if (posPoly->LM().Test(var))
-				newpairs.push_front(_CP(var, posPoly));
+			if (lm.Test(var))
+				add(_CP(var, posPoly));
 
 		// добавляем пары (f, poly), f -- явные многочлены _basis, 
 		// в список пар с учетом критериев B, С:
@@ -374,60 +816,72 @@ protected:
 		// важно: при применении критерия С в первую очередь исключается пара
 		//		  с зацеплением
 		// важно: (f_j, poly) не может быть r-парой
+		// .
+		// пары просматриваются в порядке добавления, но только те, 
+		// НОК которых делят (делятся на) НОК новой пары
 		for (posBasis = _basis.begin(); posBasis != _basis.end(); ++posBasis)
 		{
 			if (posBasis == posPoly) continue;
 			// добавляемая пара
+			const MM<_n>& lmBasis = posBasis->LM();
 			_CP newpair(posBasis, posPoly);
-			// цикл по имеющимся парам
-			posPair = newpairs.begin();
-			for (; posPair != newpairs.end();)
+			bool newrelprime = lm.IsRelPrime(lmBasis);
+			// цикл по имеющимся парам, НОК которых делят newpair.lcm
+			bool excluded = false;
+			_newlcms.Divisors(newpair.lcm, _found);
+			for (size_t pos : _found)
 			{
+				const _CP& pair = cps[pos];
 				// выполняются условия делимости?
-				if ((*posPair | newpair) && 
-					(!(posPoly->LM() | LCM(posPair->lm1, posBasis->LM()))))
+				if (!(pair | newpair) || 
+					_DividesLCM(lm, lms[pos], lmBasis))
+					continue;
+				// новая пара исключается критерием B?
+				if (pair != newpair)
 				{
-					// новая пара исключается критерием B?
-					if (*posPair != newpair)
-					{
-						_stat.b_criterion++;
-						break;
-					}
-					// действует критерий C
-					_stat.c_criterion++;
-					// новая пара исключается критерием C?
-					if (posPair->IsRelPrime() || !newpair.IsRelPrime())
-						break;
-					// новая пара исключает пару *posPair по критерию C
-					posPair = newpairs.erase(posPair);
+					_stat.b_criterion++;
+					excluded = true;
+					break;
 				}
-				else
-					++posPair;
+				// действует критерий C
+				_stat.c_criterion++;
+				// новая пара исключается критерием C?
+				if (relprime(pos) || !newrelprime)
+				{
+					excluded = true;
+					break;
+				}
+				// новая пара исключает пару pair по критерию C
+				_newlcms.Erase(pos, pair.lcm);
 			}
 			// пара исключена критерием B или С? к следующей
-			if (posPair != newpairs.end()) 
+			if (excluded) 
 				continue;
 			// снова цикл по имеющимся парам: пробуем их исключить
-			for (posPair = newpairs.begin(); posPair != newpairs.end();)
-				// критерий B исключает *posPair?
-				if ((newpair | *posPair) && newpair != *posPair &&
-					(!(posPoly->LM() | LCM(posPair->lm1, posBasis->LM()))))
-						posPair = newpairs.erase(posPair), _stat.b_criterion++;
-				else
-					++posPair;
+			// (рассматриваем пары, НОК которых делятся на newpair.lcm)
+			_newlcms.Multiples(newpair.lcm, _found);
+			for (size_t pos : _found)
+			{
+				const _CP& pair = cps[pos];
+				// критерий B исключает pair?
+				if ((newpair | pair) && newpair != pair &&
+					!_DividesLCM(lm, lms[pos], lmBasis))
+					_newlcms.Erase(pos, pair.lcm), _stat.b_criterion++;
+			}
 			// добавляем пару
-			newpairs.insert(posPair, newpair);
+			add(newpair);
 		}
 		// применяем первый критерий Бухбергера: удаляем пары без зацепления
-		for (posPair = newpairs.begin(); posPair != newpairs.end();)
-			if (posPair->IsRelPrime())
-				_stat.buch_criterion++,
-				posPair = newpairs.erase(posPair);
+		for (size_t pos = 0; pos < cps.size(); ++pos)
+			if (!_newlcms.IsUsed(pos))
+				continue;
+			else if (relprime(pos))
+				_stat.buch_criterion++;
 			else
-				++posPair;
-		// слияние списков пар
+				newpairs.push_back(cps[pos]);
+		// добавление пар в очередь
 		newpairs.sort();
-		_pairs.merge(newpairs);
+		_Push(newpairs);
 	}
 
 protected:
@@ -447,6 +901,14 @@ protected:
 		return true;
 	}
 
+	//! Прекращение вычислений
+	/*! Устанавливается признак прекращения. Оставшиеся многочлены 
+		в Update() и критические пары в Process() не обрабатываются. */
+	void Stop()
+	{
+		_stopped = true;
+	}
+
 public:
 	//! Инициализация
 	/*! Выполняется инициализация данных для работы алгоритма Бухбергера. 
@@ -460,8 +922,10 @@ public:
 		_basis.SetOrder(_O());
 		_reserve.SetOrder(_O());
 		// готовим списки пар
-		_pairs.clear();
+		_pairs.Clear(), _lcms.Clear();
 		_pairs_processed.clear();
+		_sugar.clear();
+		_stopped = false;
 		// обнуляем статистику
 		std::memset(&_stat, 0, sizeof(_stat));
 	}
@@ -484,8 +948,10 @@ public:
 		// загружаем базис Гребнера
 		_basis = gb;
 		// очищаем списки пар
-		_pairs.clear();
+		_pairs.Clear(), _lcms.Clear();
 		_pairs_processed.clear();
+		_sugar.clear();
+		_stopped = false;
 		// обнуляем статистику
 		std::memset(&_stat, 0, sizeof(_stat));
 	}
@@ -506,6 +972,7 @@ public:
 			_basis.Reduce(pos);
 			// ненулевой? обновить : исключить 
 			if (*pos != 0 && Validate(*pos)) 
+				_sugar[&*pos] = u32(std::max(poly.Deg(), pos->Deg())),
 				_basis.Move(pos), 
 				_Update(pos);
 			else _basis.RemoveAt(pos);
@@ -523,15 +990,20 @@ public:
 	{
 		// упрощаем систему многочленов
 		_I polys(_basis.GetOrder()); 
-		(polys = ideal).SelfReduce();
+		polys = ideal;
+		if (_pool)
+			polys.SelfReduce(*_pool);
+		else
+			polys.SelfReduce();
 		// добавляем многочлены и критические пары
-		for (; !polys.IsEmpty(); polys.RemoveAt(polys.begin()))
+		for (; !_stopped && !polys.IsEmpty(); polys.RemoveAt(polys.begin()))
 		{
 			// предварительная проверка
 			MP<_n, _O> poly(*polys.begin());
 			if (!ValidatePre(poly))
 				continue;
 			// редукция
+			u32 sugar = u32(poly.Deg());
 			_basis.Reduce(poly);
 			if (poly == 0)
 				continue;
@@ -539,6 +1011,7 @@ public:
 			if (Validate(poly))
 			{
 				_Iterator pos = _basis.Insert(poly);
+				_sugar[&*pos] = std::max(sugar, u32(poly.Deg()));
 				_Update(pos);
 			}
 			// трассировка
@@ -557,17 +1030,21 @@ public:
 	{	
 		_P spoly(_basis.GetOrder());
 		// обрабатываем пары
-		while (_pairs.size())
+		while (!_stopped && !_pairs.IsEmpty())
 		{
-			// найти S-многочлен 
-			_pairs.begin()->GetSPoly(spoly);
+			// выбрать пару и найти S-многочлен 
+			_CP cp = _PopPair();
+			cp.GetSPoly(spoly);
+			u32 sugar = _PairSugar(cp);
+			// сохранить пару в истории
+			if (_history)
+			{
+				if (_pairs_processed.size() == _history)
+					_pairs_processed.pop_front();
+				_pairs_processed.push_back(cp);
+			}
 			// обновить статистику
 			_stat.pairs_processed++;
-			// переместить обработанную пару
-			_pairs_processed.splice(_pairs_processed.end(), 
-				_pairs, _pairs.begin());
-			// сортировать пары
-			_pairs.sort();
 			// проверить S-многочлен
 			if (spoly == 0 || !ValidatePre(spoly))
 				continue;
@@ -580,25 +1057,279 @@ public:
 			else if (Validate(spoly)) 
 			{
 				_Iterator pos = _basis.Insert(spoly);
+				_sugar[&*pos] = std::max(sugar, u32(spoly.Deg()));
 				_Update(pos);
 				_stat.max_deg = std::max(_stat.max_deg, spoly.Deg());
 			}
 			// трассировка
 			if (_stat.pairs_processed % 23 == 0)
 				Env::Trace("Buchb: %zu cp / %zu poly / %zu cp left", 
-					_stat.pairs_processed, _basis.Size(), _pairs.size());
+					_stat.pairs_processed, _basis.Size(), _pairs.Size());
+			// автоматический снимок
+			_AutoCheckpoint();
 		}
 	}
 
 	//! Завершение
 	/*! Окончание вычислений. По ссылке ideal 
-		возвращается результат выполнения метода Process(). */
+		возвращается результат выполнения метода Process() 
+		в мономиальном порядке базиса. 
+		\remark Хвосты многочленов базиса не приводятся по старшим мономам 
+		многочленов, добавленных позже. Поэтому результат саморедуцируется 
+		и, если все S-многочлены учтены, является редуцированным базисом 
+		Гребнера. */
 	void Done(_I& ideal) const
 	{
+		ideal.SetOrder(_basis.GetOrder());
 		ideal = _basis;
+		if (_pool)
+			ideal.SelfReduce(*_pool);
+		else
+			ideal.SelfReduce();
 		Env::Trace("");
 	}
 
+// контрольные точки
+protected:
+	//! Автоматический снимок
+	/*! Если наступило время очередного снимка, то он создается. */
+	void _AutoCheckpoint()
+	{
+		if (_checkpoint.path.empty())
+			return;
+		if (_checkpoint.pairs &&
+				_stat.pairs_processed - _checkpoint.last_pairs >= 
+					_checkpoint.pairs ||
+			_checkpoint.secs &&
+				Env::Secs() - _checkpoint.last_secs >= _checkpoint.secs)
+			SaveCheckpoint(_checkpoint.path.c_str());
+	}
+
+public:
+	//! Сохранить снимок
+	/*! Состояние вычислений сохраняется в файле path. Сначала снимок 
+		записывается во временный файл, который затем переименовывается, 
+		так что при сбое во время записи предыдущий снимок не теряется. 
+		\pre Базис и резерв нормализованы (их нормализует Load(), поэтому 
+		номера многочленов в критических парах сохраняются при загрузке). 
+		\remark Снимок переносим только между платформами с одинаковой 
+		длиной машинного слова и одинаковым порядком байтов (см. io.h). 
+		\return Признак успеха. Снимок не создается, если многочлен 
+		какой-либо пары отсутствует в базисе и резерве. */
+	bool SaveCheckpoint(const char* path)
+	{
+		static_assert(std::is_trivially_copyable<_O>::value,
+			"Buchb::SaveCheckpoint: trivially copyable order expected");
+		assert(_basis.IsNormalized() && _reserve.IsNormalized());
+		// номера многочленов: многочлен -> (список, номер)
+		std::map<const _P*, std::pair<u8, u64>> index;
+		u64 i = 0;
+		for (auto iter = _basis.begin(); iter != _basis.end(); ++iter)
+			index[&*iter] = std::make_pair(u8(0), i++);
+		i = 0;
+		for (auto iter = _reserve.begin(); iter != _reserve.end(); ++iter)
+			index[&*iter] = std::make_pair(u8(1), i++);
+		// позиции многочленов пар (все должны найтись)
+		bool found = true;
+		auto locate = [&](const _P& poly)
+		{
+			auto iter = index.find(&poly);
+			if (iter != index.end())
+				return iter->second;
+			found = false;
+			return std::make_pair(u8(0xFF), u64(0));
+		};
+		_pairs.ForEach([&](const _CP& cp, u32)
+		{
+			locate(*cp.iter2);
+			if (cp.var1 == SIZE_MAX)
+				locate(*cp.iter1);
+		});
+		assert(found);
+		if (!found)
+			return false;
+		// заголовок, порядок, статистика, многочлены
+		std::string tmp(path);
+		tmp += ".tmp";
+		BinWriter w;
+		if (!w.Open(tmp.c_str()))
+			return false;
+		w.Write(u32(0x43324647)), w.Write(u32(2));
+		w.Write(&_basis.GetOrder(), sizeof(_O));
+		w.Write(_stat), w.Write(u32(_sel));
+		Save(w, _basis), Save(w, _reserve);
+		// сахар
+		for (auto iter = _basis.begin(); iter != _basis.end(); ++iter)
+			w.Write(_PolySugar(iter));
+		for (auto iter = _reserve.begin(); iter != _reserve.end(); ++iter)
+			w.Write(_PolySugar(iter));
+		// пары (в порядке выбора)
+		w.Write(u64(_pairs.Size()));
+		_pairs.ForEach([&](const _CP& cp, u32 key)
+		{
+			std::pair<u8, u64> pos1(0xFF, 0), pos2 = locate(*cp.iter2);
+			if (cp.var1 == SIZE_MAX)
+				pos1 = locate(*cp.iter1);
+			w.Write(u64(cp.var1)), w.Write(key);
+			w.Write(pos1.first), w.Write(pos1.second);
+			w.Write(pos2.first), w.Write(pos2.second);
+		});
+		// завершение
+		bool ok = w.Close();
+#ifdef OS_WIN
+		if (ok)
+			std::remove(path);
+#endif
+		ok = ok && std::rename(tmp.c_str(), path) == 0;
+		if (!ok)
+			std::remove(tmp.c_str());
+		else
+		{
+			_checkpoint.last_pairs = _stat.pairs_processed;
+			_checkpoint.last_secs = Env::Secs();
+		}
+		return ok;
+	}
+
+	//! Загрузить снимок
+	/*! Состояние вычислений восстанавливается из файла path, созданного 
+		методом SaveCheckpoint(). После загрузки можно продолжить вычисления 
+		вызовом Process(). 
+		\remark Load() нормализует базис и резерв. Номера многочленов 
+		в критических парах остаются верными, поскольку SaveCheckpoint() 
+		записывает уже нормализованные списки. 
+		\return Признак успеха. При ошибке выполняется Init(). */
+	bool LoadCheckpoint(const char* path)
+	{
+		Init();
+		BinReader r;
+		u32 magic, version, sel;
+		_O order;
+		bool ok = r.Open(path) && 
+			r.Read(magic) && magic == 0x43324647 && 
+			r.Read(version) && version == 2 &&
+			r.Read(static_cast<void*>(&order), sizeof(_O)) && 
+			r.Read(_stat) && r.Read(sel) && sel <= CP_SEL_DEG;
+		if (ok)
+			_sel = CPSel(sel);
+		// многочлены
+		if (ok)
+		{
+			_basis.SetOrder(order), _reserve.SetOrder(order);
+			ok = Load(r, _basis) && Load(r, _reserve);
+		}
+		// позиции многочленов
+		std::vector<_Iterator> lists[2];
+		for (auto iter = _basis.begin(); iter != _basis.end(); ++iter)
+			lists[0].push_back(iter);
+		for (auto iter = _reserve.begin(); iter != _reserve.end(); ++iter)
+			lists[1].push_back(iter);
+		// сахар
+		for (size_t l = 0; ok && l < 2; ++l)
+			for (auto iter = lists[l].begin(); ok && iter != lists[l].end(); 
+				++iter)
+				ok = r.Read(_sugar[&**iter]);
+		// пары
+		u64 count = 0;
+		ok = ok && r.Read(count);
+		for (; ok && count--;)
+		{
+			u64 var1, pos1, pos2;
+			u32 key;
+			u8 list1, list2;
+			ok = r.Read(var1) && r.Read(key) && r.Read(list1) && 
+				r.Read(pos1) && r.Read(list2) && r.Read(pos2) &&
+				list2 < 2 && pos2 < lists[list2].size();
+			if (ok && var1 != u64(SIZE_MAX))
+			{
+				ok = var1 < _n && lists[list2][pos2]->LM().Test(size_t(var1));
+				if (ok)
+					_PushPair(_CP(size_t(var1), lists[list2][pos2]), key);
+			}
+			else if (ok)
+			{
+				ok = list1 < 2 && pos1 < lists[list1].size();
+				if (ok)
+					_PushPair(
+						_CP(lists[list1][pos1], lists[list2][pos2]), key);
+			}
+		}
+		if (!ok)
+			Init();
+		_checkpoint.last_pairs = _stat.pairs_processed;
+		_checkpoint.last_secs = Env::Secs();
+		return ok;
+	}
+
+	//! Стратегия выбора пар
+	/*! Устанавливается стратегия выбора критических пар sel. Ключи уже 
+		сформированных пар пересчитываются. */
+	void SetSelection(CPSel sel)
+	{
+		_sel = sel;
+		_pairs.Rekey([this](const _CP& cp) { return _Key(cp); });
+	}
+
+	//! Стратегия выбора пар
+	CPSel GetSelection() const
+	{
+		return _sel;
+	}
+
+	//! Пул потоков
+	/*! Устанавливается пул потоков pool, на исполнителях которого 
+		саморедуцируются системы, передаваемые в Update(). При pool == 0
+		(по умолчанию) самоприведение последовательное. 
+		\remark Результат самоприведения от pool не зависит. */
+	void SetPool(Pool* pool)
+	{
+		_pool = pool;
+	}
+
+	//! Настроить историю обработанных пар
+	/*! Устанавливается число count последних обработанных пар, которые 
+		сохраняются для анализа (см. GetHistory()). При count == 0 
+		(по умолчанию) история не ведется, при count == SIZE_MAX 
+		сохраняются все пары. 
+		\remark Критерии исключения пар историю не используют, поэтому 
+		ее длина не влияет на результат. При длительных вычислениях полная 
+		история может занимать основную часть памяти. */
+	void SetHistory(size_t count)
+	{
+		_history = count;
+		while (_pairs_processed.size() > _history)
+			_pairs_processed.pop_front();
+	}
+
+	//! Число необработанных пар
+	size_t PairsLeft() const
+	{
+		return _pairs.Size();
+	}
+
+	//! История обработанных пар
+	/*! Возвращается список последних обработанных пар (в порядке 
+		обработки). */
+	const _CPs& GetHistory() const
+	{
+		return _pairs_processed;
+	}
+
+	//! Настроить автоматические снимки
+	/*! Во время работы Process() состояние вычислений сохраняется 
+		в файле path через каждые pairs обработанных критических пар
+		или через каждые secs секунд. Нулевое значение pairs или secs 
+		отключает соответствующее условие, пустое или нулевое path -- 
+		снимки вообще. */
+	void SetCheckpoint(const char* path, size_t pairs, u32 secs = 0)
+	{
+		_checkpoint.path = path ? path : "";
+		_checkpoint.pairs = pairs;
+		_checkpoint.secs = secs;
+		_checkpoint.last_pairs = _stat.pairs_processed;
+		_checkpoint.last_secs = Env::Secs();
+	}
+
 	//! Печать статистики 
 	/*! Печатается статистика работы. */
 	void PrintStat() const
@@ -621,9 +1352,10 @@ public:
 	}
 	
 	//! Конструктор
-	Buchb() 
+	Buchb() : _history(0), _sel(CP_SEL_NORMAL), _pool(0), _stopped(false)
 	{
 		std::memset(&_stat, 0, sizeof(_stat));
+		SetCheckpoint(0, 0);
 	}
 };
 
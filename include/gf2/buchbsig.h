@@ -0,0 +1,593 @@
+/*
+*******************************************************************************
+\file buchbsig.h
+\brief Signature-based Groebner basis algorithm
+\project GF2 [algebra over GF(2)]
+\created 2026.10.16
+\version 2026.10.16
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file buchbsig.h
+\brief Сигнатурный алгоритм построения базиса Гребнера
+
+Модуль содержит описание и реализацию класса BuchbSig, поддерживающего
+сигнатурный алгоритм (семейство F5/GVW) построения базиса Гребнера.
+В отличие от Buchb, критические пары, которые заведомо приводятся к нулю,
+исключаются до редукции.
+*******************************************************************************
+*/
+
+#ifndef __GF2_BUCHBSIG
+#define __GF2_BUCHBSIG
+
+#include "gf2/buchb.h"
+#include <cstring>
+#include <vector>
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс BuchbSig
+
+Реализация сигнатурного алгоритма вычисления базиса Гребнера.
+
+Модель вычислений совпадает с моделью Buchb:
+\code
+	BuchbSig<n, O> bs;
+	bs.Init(); // или bs.Init(gb)
+	bs.Update(s); // s -- система многочленов или многочлен
+	bs.Process();
+	bs.Done(s);
+	...
+	bs.Update(p); // добавить в систему новый многочлен
+	bs.Process(); // и пересчитать базис
+	bs.Done(s);
+\endcode
+
+Вычисления ведутся в модуле над кольцом GF(2)[x_0,...,x_{n-1}],
+образующими которого являются уравнения поля x_i^2 - x_i и многочлены f_k,
+переданные в Update() (k = 1, 2, ..., в порядке передачи). Каждый многочлен
+базиса g сопровождается сигнатурой t e_k -- старшим членом представления
+g = \sum u_j f_j + \sum v_i (x_i^2 - x_i). Сигнатуре t e_k назначается вес
+deg(t) + d_k, где d_k -- степень f_k. Сигнатуры сравниваются сначала
+по весу, затем по номеру k и, наконец, по мономам t в порядке grlex
+(по степени, при равенстве степеней -- по самой правой ненулевой координате
+разности экспонент). Порядок сигнатур не зависит от порядка _O.
+Компоненты уравнений поля младше всех e_k того же веса и явно не хранятся:
+редукция по ним -- это правило x_i^2 = x_i умножения мультилинейных
+многочленов. Учет веса (а не только номера k) позволяет обрабатывать
+пары по возрастанию степени, как в Buchb, и не строить базисы
+промежуточных систем f_1, f_2,..., f_k.
+
+Вместо критических пар обрабатываются их сигнатуры T (старшая из сигнатур
+двух слагаемых S-многочлена). Пары выбираются в порядке возрастания T,
+S-многочлены приводятся только регулярно: многочленом u g, сигнатура
+которого меньше T. Пара исключается без редукции, если
+-	T делится на сигнатуру известной сизигии (критерий сизигий). Известными
+	считаются:
+	-	главные сизигии уравнений поля (x_i^2 - x_i) e_k - f_k E_i,
+		поэтому исключаются все T, в которые переменная входит в квадрате;
+	-	сизигии g (g + 1) = 0, которые выполняются для многочленов
+		со значениями в GF(2), и сизигии (x_i + 1) g = 0 для переменных x_i,
+		которые входят во все мономы g;
+	-	сизигии Кошуля g h' - h g' для пар многочленов базиса
+		(h' и g' -- представления h и g);
+	-	сигнатуры S-многочленов, которые все-таки приведены к нулю;
+-	T делится на сигнатуру многочлена базиса, добавленного позже того,
+	который определяет T (критерий перезаписи, [ER13]);
+-	сигнатура T уже обработана или результат редукции имеет сигнатуру T
+	и старший моном, который делится на старший моном многочлена базиса
+	с той же сигнатурой (сингулярный критерий, [GVW16]).
+
+Результирующий базис не минимален. В Done() он самоприводится и возвращается
+редуцированный базис Гребнера, который совпадает с результатом Buchb.
+
+Число S-многочленов, приведенных к нулю, и число пар, исключенных
+критериями до редукции (т.е. избежавших ее), возвращают методы
+ZeroReductions() и AvoidedReductions(). Сингулярный критерий проверяется
+после редукции, и отброшенные им пары не считаются избежавшими редукции.
+
+[ER13]  Eder C., Roune B.H. Signature rewriting in Gröbner basis
+        computation, Proc. ISSAC'13, 331-338, 2013.
+[GVW16] Gao S., Volny F., Wang M. A new framework for computing Gröbner
+        bases, Math. Comp., 85: 449-465, 2016.
+*******************************************************************************
+*/
+
+template<size_t _n, class _O> class BuchbSig
+{
+// внутренние типы и данные
+protected:
+	typedef MP<_n, _O> _P;
+	typedef MI<_n, _O> _I;
+	//! Многочлен базиса
+	struct _Elem
+	{
+		_P poly; //< многочлен
+		size_t index; //< номер компоненты сигнатуры (0 -- Init(gb))
+		MM<_n> sig; //< моном сигнатуры
+		size_t local; //< номер среди многочленов той же компоненты
+		MM<_n> top; //< старший в порядке сигнатур моном poly
+	};
+	//! Компонента модуля
+	struct _Comp
+	{
+		size_t weight; //< вес образующей e_k
+		std::vector<size_t> elems; //< многочлены базиса с сигнатурами в e_k
+		MMIndex<_n> sigs; //< сигнатуры elems
+		MMIndex<_n> syz; //< сигнатуры сизигий
+		size_t syzCount; //< число сигнатур в syz
+	};
+	//! Критическая пара
+	/*! Пара задается сигнатурой T (вес T -- ключ в очереди) и многочленом
+		elem1, который определяет T. Вторым многочленом является elem2
+		или уравнение поля x_var^2 - x_var (elem2 == SIZE_MAX).
+		Если elem1 == SIZE_MAX, то пара -- это образующая f_index. */
+	struct _Pair
+	{
+		size_t index; //< номер компоненты сигнатуры
+		MM<_n> sig; //< моном сигнатуры
+		size_t elem1; //< многочлен, определяющий сигнатуру
+		size_t elem2; //< второй многочлен
+		size_t var; //< уравнение поля
+
+		bool operator<(const _Pair& right) const
+		{
+			if (index != right.index)
+				return index < right.index;
+			return _MonCmp(sig, MM<_n>(), right.sig, MM<_n>()) < 0;
+		}
+	};
+	_O _order; // мономиальный порядок
+	std::vector<_Elem> _elems; // многочлены базиса
+	MMIndex<_n> _lms; // старшие мономы _elems
+	std::vector<_Comp> _comps; // компоненты (0 -- Init(gb))
+	std::vector<_P> _gens; // образующие, ожидающие обработки
+	CPQueue<_Pair> _pairs; // критические пары
+	size_t _weight; // вес последней обработанной сигнатуры
+	_Pair _last; // последняя обработанная пара
+	bool _hasLast; // пара _last определена
+	std::vector<word> _mask; // маска позиций индексов
+	struct
+	{
+		size_t pairs_processed; // обработано критических пар
+		size_t reduction_to_zero; // число S-многочленов, приведенных к 0
+		int max_deg; // максимальная степень S-многочленов
+		size_t field_criterion; // исключено главными сизигиями уравнений поля
+		size_t syz_criterion; // исключено остальными сизигиями
+		size_t rewrite_criterion; // исключено критерием перезаписи
+		size_t singular_criterion; // отброшено сингулярным критерием
+		size_t syzygies; // найдено сигнатур сизигий
+	} _stat; // статистика
+
+// сигнатуры
+protected:
+	//! Сравнение мономов сигнатур
+	/*! Сравниваются мономы p1 q1 и p2 q2, где p -- переменные, которые
+		входят в моном, q -- переменные, которые входят в квадрате (q | p).
+		Мономы сравниваются в порядке grlex.
+		\return -1 (<), 0 (=), 1 (>). */
+	static int _MonCmp(const MM<_n>& p1, const MM<_n>& q1,
+		const MM<_n>& p2, const MM<_n>& q2)
+	{
+		int deg1 = p1.Deg() + q1.Deg(), deg2 = p2.Deg() + q2.Deg();
+		if (deg1 != deg2)
+			return deg1 < deg2 ? -1 : 1;
+		for (size_t pos = p1.WordSize(); pos--;)
+		{
+			word dp = p1.GetWord(pos) ^ p2.GetWord(pos);
+			word dq = q1.GetWord(pos) ^ q2.GetWord(pos);
+			word d = dp | dq;
+			if (d == 0)
+				continue;
+			// старший ненулевой бит d
+			for (; d & (d - 1); d &= d - 1);
+			if (dp & d)
+				return p1.GetWord(pos) & d ? 1 : -1;
+			return q1.GetWord(pos) & d ? 1 : -1;
+		}
+		return 0;
+	}
+
+	//! Вес сигнатуры
+	/*! Определяется вес сигнатуры u s e_index (произведение u s
+		вычисляется в GF(2)[x]). */
+	size_t _Weight(size_t index, const MM<_n>& u, const MM<_n>& s) const
+	{
+		return u.Deg() + s.Deg() + _comps[index].weight;
+	}
+
+	//! Сравнение сигнатур
+	/*! Сравниваются сигнатуры u1 s1 e_index1 и u2 s2 e_index2 (произведения
+		вычисляются в GF(2)[x]). Сигнатуры компоненты 0 младше остальных.
+		\return -1 (<), 0 (=), 1 (>). */
+	int _SigCmp(size_t index1, const MM<_n>& u1, const MM<_n>& s1,
+		size_t index2, const MM<_n>& u2, const MM<_n>& s2) const
+	{
+		if (index1 == 0 || index2 == 0)
+			return index1 == index2 ? 0 : index1 == 0 ? -1 : 1;
+		size_t w1 = _Weight(index1, u1, s1), w2 = _Weight(index2, u2, s2);
+		if (w1 != w2)
+			return w1 < w2 ? -1 : 1;
+		if (index1 != index2)
+			return index1 < index2 ? -1 : 1;
+		return _MonCmp(LCM(u1, s1), GCD(u1, s1), LCM(u2, s2), GCD(u2, s2));
+	}
+
+	//! Старший моном в порядке сигнатур
+	/*! Определяется старший в порядке сигнатур моном ненулевого
+		многочлена poly. */
+	static MM<_n> _SigTop(const _P& poly)
+	{
+		assert(!poly.IsEmpty());
+		MM<_n> top = poly.LM(), none;
+		for (auto iter = poly.begin(); iter != poly.end(); ++iter)
+			if (_MonCmp(*iter, none, top, none) > 0)
+				top = *iter;
+		return top;
+	}
+
+	//! Сизигия?
+	/*! Проверяется, что сигнатура sig e_index делится на сигнатуру
+		известной сизигии. */
+	bool _IsSyz(size_t index, const MM<_n>& sig)
+	{
+		_comps[index].syz.Divisors(sig, _mask);
+		return MMIndex<_n>::Next(_mask, 0) != SIZE_MAX;
+	}
+
+	//! Добавление сизигии
+	/*! Добавляется сигнатура сизигии sig e_index. */
+	void _AddSyz(size_t index, const MM<_n>& sig)
+	{
+		if (_IsSyz(index, sig))
+			return;
+		_Comp& c = _comps[index];
+		c.syz.Insert(c.syzCount++, sig), _stat.syzygies++;
+	}
+
+	//! Перезапись?
+	/*! Проверяется, что после многочлена elem в базис добавлен многочлен
+		той же компоненты, сигнатура которого делит сигнатуру sig
+		компоненты elem. */
+	bool _IsRewritable(size_t elem, const MM<_n>& sig)
+	{
+		const _Elem& e = _elems[elem];
+		_comps[e.index].sigs.Divisors(sig, _mask);
+		return MMIndex<_n>::Next(_mask, e.local + 1) != SIZE_MAX;
+	}
+
+// вычисления
+protected:
+	//! Регулярный делитель
+	/*! Определяется многочлен базиса g, который регулярно делит моном m
+		многочлена с сигнатурой sig e_index: LM(g) | m и сигнатура
+		(m / LM(g)) g меньше sig e_index.
+		\return Номер g или SIZE_MAX, если g не найден. */
+	size_t _Reducer(const MM<_n>& m, size_t index, const MM<_n>& sig)
+	{
+		_lms.Divisors(m, _mask);
+		for (size_t elem = MMIndex<_n>::Next(_mask, 0); elem != SIZE_MAX;
+			elem = MMIndex<_n>::Next(_mask, elem + 1))
+		{
+			const _Elem& e = _elems[elem];
+			if (_SigCmp(e.index, m / e.poly.LM(), e.sig,
+				index, sig, MM<_n>()) < 0)
+				return elem;
+		}
+		return SIZE_MAX;
+	}
+
+	//! Регулярная редукция
+	/*! Многочлен poly с сигнатурой sig e_index приводится регулярными
+		делителями (см. _Reducer()). Используется geobucket. */
+	void _Reduce(_P& poly, size_t index, const MM<_n>& sig)
+	{
+		typename _P::template Geobucket<2> gb(poly);
+		poly.SetEmpty();
+		MM<_n> lm;
+		_P tmp(_order);
+		while (gb.PopLM(lm))
+		{
+			size_t elem = _Reducer(lm, index, sig);
+			if (elem == SIZE_MAX)
+			{
+				poly.push_back(lm);
+				continue;
+			}
+			const _P& g = _elems[elem].poly;
+			(tmp = g).PopLM();
+			gb.SymDiffSplice(tmp *= (lm /= g.LM()));
+		}
+	}
+
+	//! Сингулярность
+	/*! Проверяется, что моном lm многочлена с сигнатурой sig e_index
+		делится на старший моном многочлена базиса g, причем сигнатура
+		(lm / LM(g)) g совпадает с sig e_index. */
+	bool _IsSingular(const MM<_n>& lm, size_t index, const MM<_n>& sig)
+	{
+		const _Comp& c = _comps[index];
+		c.sigs.Divisors(sig, _mask);
+		for (size_t pos = MMIndex<_n>::Next(_mask, 0); pos != SIZE_MAX;
+			pos = MMIndex<_n>::Next(_mask, pos + 1))
+		{
+			const _Elem& e = _elems[c.elems[pos]];
+			if (!(e.poly.LM() | lm))
+				continue;
+			MM<_n> u = lm / e.poly.LM();
+			if (u.IsRelPrime(e.sig) && (u * e.sig) == sig)
+				return true;
+		}
+		return false;
+	}
+
+	//! Добавление пары
+	/*! Пара sp ставится в очередь, если она не исключается критериями
+		сизигий и перезаписи. */
+	void _Push(const _Pair& sp)
+	{
+		if (_IsSyz(sp.index, sp.sig))
+			_stat.syz_criterion++;
+		else if (_IsRewritable(sp.elem1, sp.sig))
+			_stat.rewrite_criterion++;
+		else
+			_pairs.Push(sp, u32(_Weight(sp.index, sp.sig, MM<_n>())));
+	}
+
+	//! Внутреннее обновление
+	/*! В базис добавляется многочлен poly с сигнатурой sig e_index.
+		Формируются новые пары и сизигии. */
+	void _Update(const _P& poly, size_t index, const MM<_n>& sig)
+	{
+		size_t elem = _elems.size();
+		_Comp& c = _comps[index];
+		_elems.push_back(_Elem{poly, index, sig, c.elems.size(),
+			_SigTop(poly)});
+		const _Elem& e = _elems.back();
+		const MM<_n>& lm = e.poly.LM();
+		// сизигия g (g + 1) = 0 (при g == 1 сизигии нет)
+		if (lm != MM<_n>() && e.top.IsRelPrime(sig))
+			_AddSyz(index, e.top * sig);
+		// сизигии (x_i + 1) g = 0 для x_i, которые входят во все мономы g
+		MM<_n> common = lm;
+		for (auto iter = e.poly.begin(); iter != e.poly.end(); ++iter)
+			common = GCD(common, *iter);
+		for (size_t var = 0; var < _n; ++var)
+			if (common.Test(var) && !sig.Test(var))
+			{
+				MM<_n> t = sig;
+				t.Set(var, 1);
+				_AddSyz(index, t);
+			}
+		// сизигии Кошуля
+		for (size_t elem1 = 0; elem1 < elem; ++elem1)
+		{
+			const _Elem& e1 = _elems[elem1];
+			int cmp = _SigCmp(index, e1.top, sig, e1.index, e.top, e1.sig);
+			if (cmp > 0 && e1.top.IsRelPrime(sig))
+				_AddSyz(index, e1.top * sig);
+			else if (cmp < 0 && e.top.IsRelPrime(e1.sig))
+				_AddSyz(e1.index, e.top * e1.sig);
+		}
+		// индексы
+		_lms.Insert(elem, lm);
+		c.sigs.Insert(c.elems.size(), sig);
+		c.elems.push_back(elem);
+		// пары (x_i^2 - x_i, poly):
+		// для x_i \not| LM(poly) сигнатура пары содержит x_i^2
+		for (size_t var = 0; var < _n; ++var)
+			if (!lm.Test(var))
+				continue;
+			else if (sig.Test(var))
+				_stat.field_criterion++;
+			else
+			{
+				_Pair sp{index, sig, elem, SIZE_MAX, var};
+				sp.sig.Set(var, 1);
+				_Push(sp);
+			}
+		// пары (g, poly)
+		for (size_t elem1 = 0; elem1 < elem; ++elem1)
+		{
+			const _Elem& e1 = _elems[elem1];
+			MM<_n> t = LCM(lm, e1.poly.LM());
+			MM<_n> u = t / lm, u1 = t / e1.poly.LM();
+			// сигнатура определяется poly?
+			int cmp = _SigCmp(index, u, sig, e1.index, u1, e1.sig);
+			if (cmp == 0)
+				continue;
+			if (cmp > 0 && !u.IsRelPrime(sig) ||
+				cmp < 0 && !u1.IsRelPrime(e1.sig))
+			{
+				_stat.field_criterion++;
+				continue;
+			}
+			if (cmp > 0)
+				_Push(_Pair{index, u * sig, elem, elem1, SIZE_MAX});
+			else
+				_Push(_Pair{e1.index, u1 * e1.sig, elem1, elem, SIZE_MAX});
+		}
+	}
+
+public:
+	//! Инициализация
+	/*! Выполняется инициализация данных для работы алгоритма.
+		Устанавливается порядок _O с параметрами по умолчанию. */
+	void Init()
+	{
+		Init(_I());
+	}
+
+	//! Инициализация
+	/*! Выполняется инициализация данных для работы алгоритма.
+		Загружается система gb, которая считается базисом Гребнера,
+		и устанавливается ее порядок. Многочлены gb образуют компоненту 0,
+		критические пары для них не строятся. */
+	void Init(const _I& gb)
+	{
+		_order = gb.GetOrder();
+		_elems.clear(), _lms.Clear();
+		_comps.assign(1, _Comp{0, {}, {}, {}, 0});
+		_gens.assign(1, _P(_order));
+		_pairs.Clear();
+		_weight = 0;
+		_hasLast = false;
+		std::memset(&_stat, 0, sizeof(_stat));
+		for (auto iter = gb.begin(); iter != gb.end(); ++iter)
+		{
+			size_t elem = _elems.size();
+			_lms.Insert(elem, iter->LM());
+			_elems.push_back(_Elem{*iter, 0, MM<_n>(), elem, _SigTop(*iter)});
+			_comps[0].elems.push_back(elem);
+		}
+	}
+
+	//! Обновление
+	/*! Многочлен poly становится образующей с новым номером компоненты.
+		Вес образующей не меньше веса обработанных сигнатур: пары,
+		порожденные poly, обрабатываются после них. */
+	template<class _O1>
+	void Update(const MP<_n, _O1>& poly)
+	{
+		if (poly == 0)
+			return;
+		size_t index = _comps.size();
+		_gens.emplace_back(_order);
+		_gens.back() = poly;
+		_comps.push_back(_Comp{std::max<size_t>(_gens.back().Deg(), _weight),
+			{}, {}, {}, 0});
+		_pairs.Push(_Pair{index, MM<_n>(), SIZE_MAX, SIZE_MAX, SIZE_MAX},
+			u32(_comps.back().weight));
+	}
+
+	//! Обновление
+	/*! Многочлены системы ideal саморедуцируются и становятся образующими
+		(в порядке возрастания). */
+	template<class _O1>
+	void Update(const MI<_n, _O1>& ideal)
+	{
+		_I polys(_order);
+		(polys = ideal).SelfReduce();
+		for (auto iter = polys.begin(); iter != polys.end(); ++iter)
+			Update(*iter);
+	}
+
+	//! Обработать критические пары
+	/*! Обрабатываются образующие и критические пары в порядке возрастания
+		сигнатур. В результате многочлены базиса образуют базис Гребнера. */
+	void Process()
+	{
+		_P spoly(_order);
+		while (!_pairs.IsEmpty())
+		{
+			// выбрать пару
+			_weight = _pairs.TopKey();
+			_Pair sp = _pairs.Pop();
+			_stat.pairs_processed++;
+			// критерии
+			if (_IsSyz(sp.index, sp.sig))
+			{
+				_stat.syz_criterion++;
+				continue;
+			}
+			if (sp.elem1 != SIZE_MAX && _IsRewritable(sp.elem1, sp.sig) ||
+				_hasLast && _last.index == sp.index && _last.sig == sp.sig)
+			{
+				_stat.rewrite_criterion++;
+				continue;
+			}
+			_last = sp, _hasLast = true;
+			// S-многочлен
+			if (sp.elem1 == SIZE_MAX)
+				spoly.Swap(_gens[sp.index]), _gens[sp.index].SetEmpty();
+			else if (sp.elem2 == SIZE_MAX)
+				(spoly = _elems[sp.elem1].poly).SPoly(sp.var);
+			else
+				spoly.SPoly(_elems[sp.elem1].poly, _elems[sp.elem2].poly);
+			// регулярная редукция
+			_Reduce(spoly, sp.index, sp.sig);
+			if (spoly == 0)
+			{
+				_stat.reduction_to_zero++;
+				_AddSyz(sp.index, sp.sig);
+			}
+			else if (_IsSingular(spoly.LM(), sp.index, sp.sig))
+				_stat.singular_criterion++;
+			else
+			{
+				_stat.max_deg = std::max(_stat.max_deg, spoly.Deg());
+				_Update(spoly, sp.index, sp.sig);
+			}
+			// трассировка
+			if (_stat.pairs_processed % 23 == 0)
+				Env::Trace("BuchbSig: %zu cp / %zu poly / %zu cp left",
+					_stat.pairs_processed, _elems.size(), _pairs.Size());
+		}
+	}
+
+	//! Завершение
+	/*! Окончание вычислений. По ссылке ideal возвращается редуцированный
+		базис Гребнера, построенный по результатам Process(). */
+	void Done(_I& ideal) const
+	{
+		ideal.SetEmpty();
+		ideal.SetOrder(_order);
+		for (auto iter = _elems.begin(); iter != _elems.end(); ++iter)
+			ideal.Insert(iter->poly);
+		ideal.SelfReduce();
+		Env::Trace("");
+	}
+
+	//! Число S-многочленов, приведенных к нулю
+	size_t ZeroReductions() const
+	{
+		return _stat.reduction_to_zero;
+	}
+
+	//! Число пар, исключенных критериями
+	/*! Возвращается число критических пар, которые исключены критериями
+		без редукции (критерием уравнений поля, критерием сизигий
+		и критерием перезаписи). */
+	size_t AvoidedReductions() const
+	{
+		return _stat.field_criterion + _stat.syz_criterion +
+			_stat.rewrite_criterion;
+	}
+
+	//! Печать статистики
+	/*! Печатается статистика работы. */
+	void PrintStat() const
+	{
+		Env::Print(
+			"BuchbSig: %zu polynomials in the signature basis\n"
+			"          %zu - critical pairs processed\n"
+			"          %zu S-polynomials were reduced to 0\n"
+			"          %d - max degree of S-polynomials\n"
+			"          %zu/%zu/%zu/%zu pairs were rejected by the "
+				"field/syzygy/rewrite/singular criteria\n"
+			"          %zu syzygy signatures were found\n",
+			_elems.size(),
+			_stat.pairs_processed, _stat.reduction_to_zero,
+			_stat.max_deg,
+			_stat.field_criterion, _stat.syz_criterion,
+			_stat.rewrite_criterion, _stat.singular_criterion,
+			_stat.syzygies);
+	}
+
+	//! Конструктор
+	BuchbSig()
+	{
+		Init();
+	}
+};
+
+} // namespace GF2
+
+#endif // __GF2_BUCHBSIG
@@ -0,0 +1,249 @@
+/*
+*******************************************************************************
+\file elimlin.h
+\brief ElimLin preprocessing
+\project GF2 [algebra over GF(2)]
+\created 2026.10.16
+\version 2026.10.17
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file elimlin.h
+\brief Предобработка ElimLin
+
+Модуль содержит описание и реализацию класса ElimLin, который упрощает
+систему многочленов, исключая переменные с помощью линейных многочленов
+ее линейной оболочки.
+*******************************************************************************
+*/
+
+#ifndef __GF2_ELIMLIN
+#define __GF2_ELIMLIN
+
+#include "gf2/mi.h"
+#include "gf2/pool.h"
+#include "gf2/smat.h"
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс ElimLin
+
+Предобработка системы уравнений {p = 0: p in system} алгоритмом ElimLin
+(Courtois, Bard, 2007). Каждый раунд состоит из двух шагов:
+1.	Линейные многочлены линейной оболочки системы находятся исключением
+	в разреженной матрице SMat, столбцы которой -- мономы системы,
+	упорядоченные сначала по убыванию степеней, а затем по убыванию
+	в мономиальном порядке системы (см. SMat::Tail()). Найденные
+	многочлены приведены: старшая переменная x_v каждого из них
+	не входит в остальные.
+2.	Все найденные соотношения x_v = l_v подставляются в систему сразу
+	(см. MI::Substitute()). Многочлены обрабатываются независимо
+	и могут обрабатываться на исполнителях пула Pool.
+Раунды повторяются, пока находятся линейные многочлены.
+
+Исключенные переменные и их выражения l_v сохраняются. По решению
+упрощенной системы решение исходной системы восстанавливается
+методом Restore().
+
+\code
+	ElimLin<n, O> el;
+	if (el.Process(system))
+		...
+	el.Restore(x);
+\endcode
+*******************************************************************************
+*/
+
+template<size_t _n, class _O> class ElimLin
+{
+protected:
+	typedef MI<_n, _O> _I;
+	typedef MP<_n, _O> _P;
+
+	//! Статистика
+	struct _Stat
+	{
+		size_t rounds; //< число раундов
+		size_t vars; //< число исключенных переменных
+		size_t polys_before; //< число многочленов до упрощения
+		size_t polys_after; //< число многочленов после упрощения
+		size_t mons_before; //< число мономов до упрощения
+		size_t mons_after; //< число мономов после упрощения
+	};
+
+	Pool* _pool; // пул потоков
+	std::vector<std::pair<size_t, _P>> _elim; // исключенные переменные
+	_Stat _stat; // статистика
+
+	//! Число мономов системы
+	static size_t _Mons(const _I& system)
+	{
+		size_t count = 0;
+		for (auto iter = system.begin(); iter != system.end(); ++iter)
+			count += iter->Size();
+		return count;
+	}
+
+	//! Линейные многочлены
+	/*! Определяются линейные многочлены линейной оболочки system
+		в приведенном ступенчатом виде.
+		\return Признак наличия 1 среди найденных многочленов. */
+	static bool _Linear(const _I& system, _I& lin)
+	{
+		const _O& order = system.GetOrder();
+		auto less = [&](const MM<_n>& m1, const MM<_n>& m2)
+		{
+			int d1 = m1.Deg(), d2 = m2.Deg();
+			return d1 != d2 ? d1 > d2 : order(m1, m2);
+		};
+		// столбцы: по убыванию степеней, затем в порядке системы
+		_P polyMons(order);
+		system.GatherMons(polyMons);
+		std::vector<MM<_n>> mons(polyMons.begin(), polyMons.end());
+		std::stable_sort(mons.begin(), mons.end(), less);
+		size_t first = 0;
+		while (first < mons.size() && mons[first].Deg() > 1)
+			++first;
+		SMat a(system.Size(), mons.size()), tail;
+		size_t i = 0;
+		for (auto iter = system.begin(); iter != system.end(); ++iter, ++i)
+		{
+			for (auto m = iter->begin(); m != iter->end(); ++m)
+				a.Row(i).push_back(std::lower_bound(mons.begin(), mons.end(),
+					*m, less) - mons.begin());
+			std::sort(a.Row(i).begin(), a.Row(i).end());
+		}
+		a.Tail(first, tail);
+		// линейные многочлены
+		lin.SetEmpty();
+		lin.SetOrder(order);
+		bool one = false;
+		for (i = 0; i < tail.Rows(); ++i)
+		{
+			auto pos = lin.insert(lin.end(), _P(order));
+			for (size_t j : tail.Row(i))
+				pos->push_back(mons[j]);
+			one = one || *pos == 1;
+		}
+		return one;
+	}
+
+public:
+	//! Упрощение
+	/*! Система system упрощается: переменные, которые выражаются через
+		другие переменные линейными многочленами линейной оболочки
+		системы, исключаются, пока такие многочлены находятся.
+		\return Признак совместности: если среди линейных многочленов
+		найдена 1, то system = {1} и возвращается false. */
+	bool Process(_I& system)
+	{
+		_elim.clear();
+		_stat.rounds = _stat.vars = 0;
+		_stat.polys_before = system.Size();
+		_stat.mons_before = _Mons(system);
+		system.Normalize();
+		_I lin;
+		bool ok = true;
+		while (!system.IsEmpty())
+		{
+			++_stat.rounds;
+			if (_Linear(system, lin))
+			{
+				system.SetEmpty();
+				system.Insert(_P(true));
+				ok = false;
+				break;
+			}
+			if (lin.IsEmpty())
+				break;
+			// соотношения x_v = l_v
+			std::map<size_t, _P> subst;
+			for (auto iter = lin.begin(); iter != lin.end(); ++iter)
+			{
+				// старшая переменная (первый моном многочлена)
+				const MM<_n>& lm = iter->LM();
+				size_t v = 0;
+				while (!lm.Test(v))
+					++v;
+				_P& l = subst.emplace(v, *iter).first->second;
+				l.pop_front();
+				_elim.emplace_back(v, l);
+			}
+			// подстановка
+			if (_pool)
+				system.Substitute(subst, *_pool);
+			else
+				system.Substitute(subst);
+			_stat.vars += subst.size();
+		}
+		_stat.polys_after = system.Size();
+		_stat.mons_after = _Mons(system);
+		return ok;
+	}
+
+	//! Восстановление решения
+	/*! По решению x упрощенной системы определяются значения исключенных
+		переменных. Результат -- решение исходной системы. */
+	void Restore(WW<_n>& x) const
+	{
+		for (auto iter = _elim.rbegin(); iter != _elim.rend(); ++iter)
+			x.Set(iter->first, iter->second.Calc(x));
+	}
+
+	//! Исключенные переменные
+	/*! Возвращается список пар (v, l_v) в порядке исключения: переменная
+		x_v заменена на многочлен l_v. Многочлен l_v может содержать
+		переменные, исключенные позже. */
+	const std::vector<std::pair<size_t, _P>>& GetEliminated() const
+	{
+		return _elim;
+	}
+
+	//! Статистика
+	const _Stat& GetStat() const
+	{
+		return _stat;
+	}
+
+	//! Печать статистики
+	void PrintStat() const
+	{
+		Env::Print(
+			"ElimLin: %zu rounds\n"
+			"         %zu variables eliminated\n"
+			"         %zu -> %zu polynomials\n"
+			"         %zu -> %zu monomials\n",
+			_stat.rounds, _stat.vars,
+			_stat.polys_before, _stat.polys_after,
+			_stat.mons_before, _stat.mons_after);
+	}
+
+	//! Пул потоков
+	/*! Устанавливается пул потоков pool, на исполнителях которого
+		выполняется подстановка. При pool == 0 (по умолчанию)
+		подстановка последовательная. */
+	void SetPool(Pool* pool)
+	{
+		_pool = pool;
+	}
+
+	//! Конструктор
+	ElimLin() : _pool(0)
+	{
+		_stat = _Stat();
+	}
+};
+
+} // namespace GF2
+
+#endif // __GF2_ELIMLIN
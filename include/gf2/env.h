@@ -4,7 +4,7 @@
 \brief The runtime environment
 \project GF2 [algebra over GF(2)]
 \created 2004.01.01
-\version 2020.04.22
+\version 2026.10.16
 \license This program is released under the MIT License. See Copyright Notices
 in GF2/info.h.
 *******************************************************************************
@@ -62,8 +62,12 @@ namespace Env
 	void Print(const wchar_t* format,...);
 
 	//! Отладочная печать
+	/*! Допускаются вызовы из нескольких потоков. */
 	void Trace(const char* format,...);
 
+	//! Включить / выключить отладочную печать
+	void SetTrace(bool on);
+
 	//! Время (в ms) с отправного момента в прошлом
 	u32 Ticks();
 
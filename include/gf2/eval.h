@@ -0,0 +1,295 @@
+/*
+*******************************************************************************
+\file eval.h
+\brief Bitsliced evaluation of polynomials at many points
+\project GF2 [algebra over GF(2)]
+\created 2026.10.16
+\version 2026.10.16
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file eval.h
+\brief Вычисление многочленов во многих точках
+
+Модуль содержит описание и реализацию класса Eval, который вычисляет
+многочлены или системы многочленов сразу во многих точках.
+*******************************************************************************
+*/
+
+#ifndef __GF2_EVAL
+#define __GF2_EVAL
+
+#include "gf2/mi.h"
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс Eval
+
+Многочлен или система многочленов компилируется в программу без ветвлений:
+каждый моном степени d > 1 вычисляется как произведение уже вычисленного
+монома степени d - 1 и переменной. Мономы, общие для разных многочленов,
+и их общие делители вычисляются один раз.
+
+Программа выполняется над блоками из _L * B_PER_W точек в транспонированном
+(bitsliced) представлении: значения переменной (монома) в точках блока
+хранятся в _L машинных словах, и одна операция AND или XOR над словами
+обрабатывает B_PER_W точек. Циклы по _L словам не содержат ветвлений
+и векторизуются компилятором. При _L = 4 и B_PER_W = 64 блок содержит
+256 точек, при _L = 8 -- 512 точек.
+
+Значения многочлена с номером j в точках points[0],..., points[count - 1]
+возвращаются в упакованном виде: значение в точке i -- это бит i % B_PER_W
+слова res[j * stride + i / B_PER_W], stride = ceil(count / B_PER_W).
+
+\code
+	Eval<n> eval;
+	eval.Compile(system);
+	std::vector<word> res;
+	eval.Calc(points.data(), points.size(), res);
+\endcode
+*******************************************************************************
+*/
+
+template<size_t _n, size_t _L = 8> class Eval
+{
+	static_assert(_L > 0, "Eval: empty block");
+
+	//! Сравнение мономов (для словаря)
+	struct _MonLess
+	{
+		bool operator()(const MM<_n>& m1, const MM<_n>& m2) const
+		{
+			for (size_t i = 0; i < m1.WordSize(); ++i)
+				if (m1.GetWord(i) != m2.GetWord(i))
+					return m1.GetWord(i) < m2.GetWord(i);
+			return false;
+		}
+	};
+
+	std::vector<size_t> _vars; //< переменные (ячейки 0, 1,...)
+	size_t _slot[_n]; //< ячейки переменных
+	std::vector<size_t> _ops; //< сомножители произведений
+	std::vector<size_t> _outs; //< ячейки мономов многочленов
+	std::vector<size_t> _offsets; //< начала многочленов в _outs
+	std::vector<bool> _consts; //< свободные члены многочленов
+	std::map<MM<_n>, size_t, _MonLess> _mons; //< ячейки мономов
+
+	//! Ячейка монома
+	/*! Определяется ячейка, в которой вычисляется моном mon степени
+		не меньше 1. Если моном еще не вычисляется, то в программу
+		добавляется его вычисление. */
+	size_t _Slot(const MM<_n>& mon)
+	{
+		auto pos = _mons.find(mon);
+		if (pos != _mons.end())
+			return pos->second;
+		// ищем вычисленный делитель mon / x_i
+		size_t var = SIZE_MAX, last = SIZE_MAX;
+		MM<_n> div(mon);
+		for (size_t i = 0; i < _n && var == SIZE_MAX; ++i)
+			if (mon.Test(i))
+			{
+				div.Set(i, 0);
+				if (_mons.find(div) != _mons.end())
+					var = i;
+				div.Set(i, 1), last = i;
+			}
+		// делителя нет: делим на старшую переменную
+		if (var == SIZE_MAX)
+			var = last;
+		div.Set(var, 0);
+		size_t src = _Slot(div);
+		_ops.push_back(src), _ops.push_back(_Var(var));
+		size_t slot = _vars.size() + _ops.size() / 2 - 1;
+		_mons.emplace(mon, slot);
+		return slot;
+	}
+
+	//! Ячейка переменной
+	size_t _Var(size_t var)
+	{
+		if (_slot[var] == SIZE_MAX)
+		{
+			// ячейки переменных предшествуют ячейкам произведений
+			assert(_ops.empty());
+			_slot[var] = _vars.size();
+			_vars.push_back(var);
+		}
+		return _slot[var];
+	}
+
+	//! Добавление многочлена
+	template<class _O>
+	void _Add(const MP<_n, _O>& poly)
+	{
+		_consts.push_back(false);
+		for (auto iter = poly.begin(); iter != poly.end(); ++iter)
+			if (iter->Deg() == 0)
+				_consts.back() = true;
+			else
+				_outs.push_back(_Slot(*iter));
+		_offsets.push_back(_outs.size());
+	}
+
+	//! Подготовка переменных
+	/*! Ячейки назначаются всем существенным переменным vars до того,
+		как появятся ячейки произведений. */
+	void _Prepare(const MM<_n>& vars)
+	{
+		Clear();
+		for (size_t i = 0; i < _n; ++i)
+			if (vars.Test(i))
+				_Var(i);
+		for (size_t i = 0; i < _vars.size(); ++i)
+		{
+			MM<_n> mon;
+			mon.Set(_vars[i], 1);
+			_mons.emplace(mon, i);
+		}
+	}
+
+public:
+	//! Очистка
+	void Clear()
+	{
+		_vars.clear(), _ops.clear(), _outs.clear(), _consts.clear();
+		_offsets.assign(1, 0);
+		_mons.clear();
+		for (size_t i = 0; i < _n; ++i)
+			_slot[i] = SIZE_MAX;
+	}
+
+	//! Компиляция многочлена
+	template<class _O>
+	void Compile(const MP<_n, _O>& poly)
+	{
+		MM<_n> vars;
+		for (auto iter = poly.begin(); iter != poly.end(); ++iter)
+			vars *= *iter;
+		_Prepare(vars);
+		_Add(poly);
+	}
+
+	//! Компиляция системы
+	/*! Многочлены системы получают номера 0, 1,... в порядке следования. */
+	template<class _O>
+	void Compile(const MI<_n, _O>& system)
+	{
+		_Prepare(system.GatherVars());
+		for (auto iter = system.begin(); iter != system.end(); ++iter)
+			_Add(*iter);
+	}
+
+	//! Число многочленов
+	size_t Size() const
+	{
+		return _consts.size();
+	}
+
+	//! Число произведений
+	/*! Определяется число операций AND в программе. */
+	size_t OpCount() const
+	{
+		return _ops.size() / 2;
+	}
+
+	//! Вычисление
+	/*! Многочлены вычисляются в точках points[0],..., points[count - 1].
+		Результаты возвращаются в упакованном виде в res
+		(см. описание класса). */
+	void Calc(const WW<_n>* points, size_t count,
+		std::vector<word>& res) const
+	{
+		const size_t stride = (count + B_PER_W - 1) / B_PER_W;
+		res.assign(Size() * stride, 0);
+		std::vector<word> slots((_vars.size() + OpCount()) * _L);
+		for (size_t first = 0; first < count; first += _L * B_PER_W)
+		{
+			size_t last = std::min(count, first + _L * B_PER_W);
+			// транспонирование
+			std::fill(slots.begin(), slots.begin() + _vars.size() * _L, 0);
+			for (size_t i = first; i < last; ++i)
+			{
+				word bit = WORD_1 << (i - first) % B_PER_W;
+				size_t k = (i - first) / B_PER_W;
+				for (size_t j = 0; j < points[i].WordSize(); ++j)
+					for (word w = points[i].GetWord(j); w; w &= w - 1)
+					{
+						size_t slot = _slot[j * B_PER_W + WordLoBit(w)];
+						if (slot != SIZE_MAX)
+							slots[slot * _L + k] |= bit;
+					}
+			}
+			// произведения
+			word* dst = slots.data() + _vars.size() * _L;
+			for (size_t op = 0; op < _ops.size(); op += 2, dst += _L)
+			{
+				const word* src1 = slots.data() + _ops[op] * _L;
+				const word* src2 = slots.data() + _ops[op + 1] * _L;
+				for (size_t k = 0; k < _L; ++k)
+					dst[k] = src1[k] & src2[k];
+			}
+			// суммы
+			size_t words = (last - first + B_PER_W - 1) / B_PER_W;
+			for (size_t j = 0; j < Size(); ++j)
+			{
+				word acc[_L];
+				for (size_t k = 0; k < _L; ++k)
+					acc[k] = _consts[j] ? WORD_MAX : 0;
+				for (size_t pos = _offsets[j]; pos < _offsets[j + 1]; ++pos)
+				{
+					const word* src = slots.data() + _outs[pos] * _L;
+					for (size_t k = 0; k < _L; ++k)
+						acc[k] ^= src[k];
+				}
+				std::copy(acc, acc + words,
+					res.data() + j * stride + first / B_PER_W);
+			}
+		}
+		// обнуление битов за пределами count
+		if (count % B_PER_W)
+			for (size_t j = 0; j < Size(); ++j)
+				res[j * stride + stride - 1] &=
+					WORD_MAX >> (B_PER_W - count % B_PER_W);
+	}
+
+	//! Вычисление
+	/*! Многочлены вычисляются в точках points. */
+	void Calc(const std::vector<WW<_n>>& points,
+		std::vector<word>& res) const
+	{
+		Calc(points.data(), points.size(), res);
+	}
+
+// конструкторы
+public:
+	Eval()
+	{
+		Clear();
+	}
+
+	template<class _O>
+	explicit Eval(const MP<_n, _O>& poly)
+	{
+		Compile(poly);
+	}
+
+	template<class _O>
+	explicit Eval(const MI<_n, _O>& system)
+	{
+		Compile(system);
+	}
+};
+
+} // namespace GF2
+
+#endif // __GF2_EVAL
@@ -0,0 +1,259 @@
+/*
+*******************************************************************************
+\file exhaust.h
+\brief Exhaustive search for zeros of polynomial systems
+\project GF2 [algebra over GF(2)]
+\created 2026.10.16
+\version 2026.10.16
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file exhaust.h
+\brief Перебор решений систем уравнений
+
+Модуль содержит описание и реализацию класса Exhaust, который находит
+все решения системы уравнений перебором значений переменных в порядке
+кода Грея.
+*******************************************************************************
+*/
+
+#ifndef __GF2_EXHAUST
+#define __GF2_EXHAUST
+
+#include "gf2/mi.h"
+#include "gf2/pool.h"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс Exhaust
+
+Перебор решений системы уравнений {p = 0: p in system} относительно
+ее существенных переменных (остальные переменные решений нулевые).
+
+Перебор ведется в порядке кода Грея: соседние наборы значений переменных
+отличаются одной переменной x_i, и значение многочлена f меняется
+на значение производной D_i f = f(x) + f(x + e_i). Производная D_i f
+не зависит от x_i, и между соседними изменениями x_i она меняется
+на значение второй производной по x_i и переменной, которая изменилась
+в промежутке. Продолжая рассуждения, приходим к тому, что на каждом шаге
+достаточно сложить не более d значений производных, где d -- степень
+системы (алгоритм FES, Bouillaguet et al., 2010). Производные порядка d
+постоянны.
+
+Уравнения обрабатываются одновременно: значения B_PER_W уравнений наименьших
+степеней упаковываются в машинное слово (bitslicing). Найденный набор,
+который обнуляет слово, проверяется на остальных уравнениях.
+
+Старшие переменные фиксируются, и пространство перебора делится
+на подпространства, которые обрабатываются на исполнителях пула Pool.
+Число нефиксированных переменных меньше B_PER_W. Число фиксированных
+переменных (номер подпространства задается их значениями) также должно
+быть меньше B_PER_W, поэтому система должна содержать не более
+2 B_PER_W - 2 существенных переменных.
+
+Решения передаются функции обратного вызова f(x). Вызовы f
+последовательны (выполняются под блокировкой), но их порядок не определен.
+
+\code
+	Pool pool;
+	Exhaust<n, O> exhaust(pool);
+	exhaust.Process(system, [&](const WW<n>& x) { ... });
+\endcode
+*******************************************************************************
+*/
+
+template<size_t _n, class _O> class Exhaust
+{
+protected:
+	typedef MI<_n, _O> _I;
+	typedef MP<_n, _O> _P;
+	Pool& _pool; // пул потоков
+	std::mutex _lock; // блокировка вызовов f
+
+	//! Обработка подпространства
+	/*! Перебираются значения переменных vars[0],..., vars[m - 1],
+		значения переменных vars[m], vars[m + 1],... задаются битами task.
+		Обнуление batch проверяется одновременно, обнуление rest --
+		для найденных решений batch. Решения передаются функции f.
+		\return Число решений. */
+	template<class _F>
+	size_t _Solve(const std::vector<const _P*>& batch,
+		const std::vector<const _P*>& rest, const std::vector<size_t>& vars,
+		size_t m, size_t task, _F& f)
+	{
+		// фиксируем старшие переменные
+		WW<_n> x;
+		std::vector<_P> polys(batch.size());
+		size_t d = 1;
+		for (size_t e = 0; e < batch.size(); ++e)
+		{
+			polys[e] = *batch[e];
+			for (size_t j = m; j < vars.size(); ++j)
+				polys[e].Set(vars[j], (task >> (j - m) & 1) != 0);
+			if (polys[e] == 1)
+				return 0;
+			d = std::max<size_t>(d, std::max(polys[e].Deg(), 0));
+		}
+		for (size_t j = m; j < vars.size(); ++j)
+			x.Set(vars[j], (task >> (j - m) & 1) != 0);
+		// номера переменных в подпространстве
+		size_t loc[_n];
+		for (size_t l = 0; l < m; ++l)
+			loc[vars[l]] = l;
+		// биномиальные коэффициенты binom[i * (d + 1) + l] = C(i, l)
+		// и смещения производных порядка l
+		std::vector<size_t> binom((m + 1) * (d + 1), 0), offset(d + 2, 0);
+		for (size_t i = 0; i <= m; ++i)
+		{
+			binom[i * (d + 1)] = 1;
+			for (size_t l = 1; l <= d && l <= i; ++l)
+				binom[i * (d + 1) + l] = binom[(i - 1) * (d + 1) + l - 1] +
+					(l < i ? binom[(i - 1) * (d + 1) + l] : 0);
+		}
+		for (size_t l = 1; l <= d; ++l)
+			offset[l + 1] = offset[l] + binom[m * (d + 1) + l];
+		// производные D_S f, S = {i_1 < ... < i_l}, хранятся в позициях
+		// offset[l] + C(i_1, 1) + ... + C(i_l, l). Начальное значение
+		// D_S f -- значение в точке g(k_S), k_S = 2^{i_1} + ... + 2^{i_l},
+		// где производная используется впервые. Для монома mon:
+		// D_S mon = mon / S, если S делит mon, и 0 иначе, g(k_S) содержит
+		// переменные x_i, i \notin S, i + 1 \in S
+		std::vector<word> der(offset[d + 1], 0);
+		word y = 0;
+		size_t pos[B_PER_W];
+		for (size_t e = 0; e < polys.size(); ++e)
+			for (auto iter = polys[e].begin(); iter != polys[e].end(); ++iter)
+			{
+				size_t deg = 0;
+				for (size_t i = 0; i < iter->WordSize(); ++i)
+					for (word w = iter->GetWord(i); w; w &= w - 1)
+						pos[deg++] = loc[i * B_PER_W + WordLoBit(w)];
+				if (deg == 0)
+				{
+					y ^= WORD_1 << e;
+					continue;
+				}
+				for (size_t mask = 1; mask >> deg == 0; ++mask)
+				{
+					size_t i = 0, l = 0, r = 0;
+					for (; i < deg; ++i)
+						if (mask >> i & 1)
+							r += binom[pos[i] * (d + 1) + ++l];
+						else if (i + 1 == deg || !(mask >> (i + 1) & 1) ||
+							pos[i + 1] != pos[i] + 1)
+							break;
+					if (i == deg)
+						der[offset[l] + r] ^= WORD_1 << e;
+				}
+			}
+		// перебор
+		size_t count = 0;
+		if (y == 0)
+			count += _Report(rest, x, f);
+		size_t b[B_PER_W], r[B_PER_W];
+		for (word k = 1; k >> m == 0; ++k)
+		{
+			// младшие ненулевые биты k
+			size_t t = 0;
+			for (word c = k; c && t < d; c &= c - 1, ++t)
+			{
+				b[t] = WordLoBit(c);
+				r[t] = (t ? r[t - 1] - offset[t] : 0) + offset[t + 1] +
+					binom[b[t] * (d + 1) + t + 1];
+			}
+			// обновляем производные и значение
+			while (--t)
+				der[r[t - 1]] ^= der[r[t]];
+			y ^= der[r[0]];
+			x.Flip(vars[b[0]]);
+			if (y == 0)
+				count += _Report(rest, x, f);
+		}
+		return count;
+	}
+
+	//! Проверка и передача решения
+	/*! Решение x уравнений batch проверяется на уравнениях rest
+		и передается функции f.
+		\return Число переданных решений (0 или 1). */
+	template<class _F>
+	size_t _Report(const std::vector<const _P*>& rest, const WW<_n>& x,
+		_F& f)
+	{
+		for (auto iter = rest.begin(); iter != rest.end(); ++iter)
+			if ((*iter)->Calc(x))
+				return 0;
+		std::lock_guard<std::mutex> guard(_lock);
+		f(x);
+		return 1;
+	}
+
+public:
+	//! Перебор
+	/*! Находятся все решения системы system. Каждое решение x передается
+		функции f(x).
+		\pre Число существенных переменных system не больше 2 B_PER_W - 2.
+		\return Число решений. */
+	template<class _F>
+	size_t Process(const _I& system, _F&& f)
+	{
+		// уравнения наименьших степеней обрабатываются одновременно
+		std::vector<const _P*> batch, rest;
+		for (auto iter = system.begin(); iter != system.end(); ++iter)
+			batch.push_back(&*iter);
+		std::stable_sort(batch.begin(), batch.end(),
+			[](const _P* p1, const _P* p2)
+			{
+				return p1->Deg() < p2->Deg();
+			});
+		if (batch.size() > B_PER_W)
+		{
+			rest.assign(batch.begin() + B_PER_W, batch.end());
+			batch.resize(B_PER_W);
+		}
+		// существенные переменные
+		std::vector<size_t> vars;
+		MM<_n> mon = system.GatherVars();
+		for (size_t pos = 0; pos < _n; ++pos)
+			if (mon.Test(pos))
+				vars.push_back(pos);
+		// число нефиксированных переменных
+		size_t m = vars.size();
+		while (_pool.Size() > 1 && m > 0 &&
+			(size_t(1) << (vars.size() - m)) < 4 * _pool.Size())
+			--m;
+		if (m >= B_PER_W)
+			m = B_PER_W - 1;
+		assert(vars.size() - m < B_PER_W);
+		// перебор по подпространствам
+		size_t tasks = size_t(1) << (vars.size() - m);
+		std::vector<size_t> counts(tasks, 0);
+		_pool.Run(tasks, [&](size_t, size_t task)
+		{
+			counts[task] = _Solve(batch, rest, vars, m, task, f);
+		});
+		size_t count = 0;
+		for (size_t task = 0; task < tasks; ++task)
+			count += counts[task];
+		return count;
+	}
+
+	//! Конструктор
+	/*! Перебор ведется на исполнителях пула pool. */
+	explicit Exhaust(Pool& pool) : _pool(pool)
+	{
+	}
+};
+
+} // namespace GF2
+
+#endif // __GF2_EXHAUST
@@ -0,0 +1,344 @@
+/*
+*******************************************************************************
+\file fglm.h
+\brief FGLM order conversion
+\project GF2 [algebra over GF(2)]
+\created 2026.10.17
+\version 2026.10.17
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file fglm.h
+\brief Смена мономиального порядка (FGLM)
+
+Модуль содержит описание и реализацию класса FGLM, который по базису
+Гребнера в одном мономиальном порядке строит базис Гребнера того же
+идеала в другом порядке.
+*******************************************************************************
+*/
+
+#ifndef __GF2_FGLM
+#define __GF2_FGLM
+
+#include "gf2/mi.h"
+#include "gf2/mm.h"
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <vector>
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс FGLM
+
+Смена мономиального порядка базиса Гребнера (алгоритм FGLM, Faugere,
+Gianni, Lazard, Mora, 1993). В булевом кольце все идеалы
+нульмерны, поэтому алгоритм применим к любому базису.
+
+Исходный базис gb -- базис Гребнера в порядке _O
+(как правило, grevlex, в котором базис вычисляется быстрее всего).
+Мономы рассматриваются относительно существенных переменных gb.
+Нормальные формы многочленов по gb -- векторы в базисе факторкольца
+(см. MI::QuotientBasis()) размерности D.
+
+Мономы-кандидаты перебираются по возрастанию в целевом порядке,
+начиная с 1. Нормальная форма кандидата m = s x_v, где s -- уже найденный
+стандартный моном целевого порядка, вычисляется по нормальной форме s
+с помощью матрицы умножения на x_v: столбец матрицы -- нормальная форма
+x_v b для элемента b базиса факторкольца. Столбцы вычисляются приведением
+по gb при первом обращении и кэшируются.
+
+Линейная зависимость нормальной формы от нормальных форм найденных
+стандартных мономов проверяется приведением по ступенчатой системе
+векторов с различными ведущими координатами. Вместе с векторами хранятся
+их выражения через стандартные мономы. Если нормальная форма m приводится
+к нулю, то многочлен m + s_1 + ... + s_k, где s_i -- мономы выражения,
+входит в целевой базис. Иначе m становится стандартным мономом,
+и его произведения на переменные добавляются в кандидаты. Кандидаты,
+которые делятся на старшие мономы найденных многочленов, пропускаются.
+Полученный базис редуцирован.
+
+Векторы хранятся плотно (машинными словами) или, если размерность D
+велика (см. SetSparseDim()), разреженно (номерами ненулевых координат).
+
+\code
+	FGLM<n, MOGrevlex<n>> fglm;
+	MI<n, MOLex<n>> lex;
+	fglm.Process(gb, lex);
+\endcode
+*******************************************************************************
+*/
+
+template<size_t _n, class _O> class FGLM
+{
+protected:
+	typedef MI<_n, _O> _I;
+	typedef MP<_n, _O> _P;
+
+	//! Плотные векторы
+	struct _Dense
+	{
+		typedef std::vector<word> V;
+
+		static void Init(V& a, size_t dim)
+		{
+			a.assign((dim + B_PER_W - 1) / B_PER_W, 0);
+		}
+
+		static void Set(V& a, size_t i)
+		{
+			a[i / B_PER_W] |= WORD_1 << i % B_PER_W;
+		}
+
+		static void Xor(V& a, const V& b)
+		{
+			for (size_t pos = 0; pos < a.size(); ++pos)
+				a[pos] ^= b[pos];
+		}
+
+		static size_t Lead(const V& a, size_t from = 0)
+		{
+			for (size_t pos = from / B_PER_W; pos < a.size(); ++pos)
+				if (a[pos])
+					return pos * B_PER_W + WordLoBit(a[pos]);
+			return SIZE_MAX;
+		}
+
+		template<class _F> static void ForEach(const V& a, _F&& f)
+		{
+			for (size_t pos = 0; pos < a.size(); ++pos)
+				for (word w = a[pos]; w; w &= w - 1)
+					f(pos * B_PER_W + WordLoBit(w));
+		}
+	};
+
+	//! Разреженные векторы
+	struct _Sparse
+	{
+		typedef std::vector<size_t> V;
+
+		static void Init(V& a, size_t)
+		{
+			a.clear();
+		}
+
+		//! \pre i больше номеров ненулевых координат a
+		static void Set(V& a, size_t i)
+		{
+			a.push_back(i);
+		}
+
+		static void Xor(V& a, const V& b)
+		{
+			V c;
+			c.reserve(a.size() + b.size());
+			std::set_symmetric_difference(a.begin(), a.end(), b.begin(),
+				b.end(), std::back_inserter(c));
+			a.swap(c);
+		}
+
+		static size_t Lead(const V& a, size_t = 0)
+		{
+			return a.empty() ? SIZE_MAX : a.front();
+		}
+
+		template<class _F> static void ForEach(const V& a, _F&& f)
+		{
+			for (size_t i : a)
+				f(i);
+		}
+	};
+
+	//! Статистика
+	struct _Stat
+	{
+		size_t dim; //< размерность факторкольца
+		size_t forms; //< число вычисленных столбцов матриц умножения
+		size_t polys; //< число многочленов целевого базиса
+		bool sparse; //< использовались разреженные векторы
+	};
+
+	size_t _sparseDim; // наименьшая размерность для разреженных векторов
+	_Stat _stat; // статистика
+
+	//! Смена порядка
+	/*! Реализация Process() с векторами типа _S::V. */
+	template<class _S, class _O2>
+	void _Process(const _I& gb, const std::vector<size_t>& vars,
+		const _P& qb, MI<_n, _O2>& result)
+	{
+		typedef typename _S::V V;
+		const _O& order = gb.GetOrder();
+		const _O2& order2 = result.GetOrder();
+		const size_t dim = qb.Size();
+		std::vector<MM<_n>> basis(qb.begin(), qb.end());
+		// нормальная форма многочлена по gb
+		auto form = [&](_P& poly, V& vec)
+		{
+			gb.Reduce(poly);
+			_S::Init(vec, dim);
+			// мономы poly и basis упорядочены по убыванию
+			size_t i = 0;
+			for (auto iter = poly.begin(); iter != poly.end(); ++iter)
+			{
+				while (basis[i] != *iter)
+					++i;
+				_S::Set(vec, i);
+			}
+		};
+		// матрицы умножения: mult[j][i] -- нормальная форма x_v b_i,
+		// v = vars[j]
+		std::vector<std::vector<V>> mult(vars.size());
+		std::vector<std::vector<bool>> ready(vars.size());
+		auto column = [&](size_t j, size_t i) -> const V&
+		{
+			if (mult[j].empty())
+				mult[j].resize(dim), ready[j].assign(dim, false);
+			if (!ready[j][i])
+			{
+				_P poly(order);
+				poly.push_back(basis[i]);
+				poly.back().Set(vars[j], 1);
+				form(poly, mult[j][i]);
+				ready[j][i] = true, ++_stat.forms;
+			}
+			return mult[j][i];
+		};
+		// ступенчатая система: строки, их выражения, ведущие координаты
+		std::vector<V> rows, combs;
+		std::vector<size_t> pivot(dim, SIZE_MAX);
+		// стандартные мономы целевого порядка и их нормальные формы
+		std::vector<MM<_n>> stairs;
+		std::vector<V> forms;
+		// старшие мономы целевого базиса
+		MMIndex<_n> lms;
+		std::vector<word> mask;
+		size_t count = 0;
+		// кандидаты по возрастанию: (стандартный моном, номер в vars)
+		auto less = [&](const MM<_n>& m1, const MM<_n>& m2)
+		{
+			return order2(m2, m1);
+		};
+		std::map<MM<_n>, std::pair<size_t, size_t>, decltype(less)>
+			cands(less);
+		cands.emplace(MM<_n>(), std::make_pair(SIZE_MAX, SIZE_MAX));
+		V vec, comb, tmp;
+		while (!cands.empty())
+		{
+			MM<_n> m = cands.begin()->first;
+			auto from = cands.begin()->second;
+			cands.erase(cands.begin());
+			// делится на старший моном?
+			lms.Divisors(m, mask);
+			if (MMIndex<_n>::Next(mask, 0) != SIZE_MAX)
+				continue;
+			// нормальная форма
+			if (from.first == SIZE_MAX)
+			{
+				_P poly(order);
+				poly.push_back(m);
+				form(poly, vec);
+			}
+			else
+			{
+				_S::Init(vec, dim);
+				_S::ForEach(forms[from.first], [&](size_t i)
+				{
+					_S::Xor(vec, column(from.second, i));
+				});
+			}
+			// приведение по ступенчатой системе
+			tmp = vec;
+			_S::Init(comb, dim);
+			for (size_t p = _S::Lead(tmp); p != SIZE_MAX &&
+				pivot[p] != SIZE_MAX; p = _S::Lead(tmp, p))
+			{
+				_S::Xor(tmp, rows[pivot[p]]);
+				_S::Xor(comb, combs[pivot[p]]);
+			}
+			// зависимость: многочлен целевого базиса
+			if (_S::Lead(tmp) == SIZE_MAX)
+			{
+				MP<_n, _O2> poly(order2);
+				poly.push_back(m);
+				_S::ForEach(comb, [&](size_t k) { poly.push_back(stairs[k]); });
+				poly.Normalize();
+				result.insert(result.end(), MP<_n, _O2>(order2))->Swap(poly);
+				lms.Insert(count++, m);
+				continue;
+			}
+			// новый стандартный моном
+			_S::Set(comb, stairs.size());
+			pivot[_S::Lead(tmp)] = rows.size();
+			rows.push_back(tmp), combs.push_back(comb);
+			stairs.push_back(m), forms.push_back(vec);
+			for (size_t j = 0; j < vars.size(); ++j)
+				if (!m.Test(vars[j]))
+				{
+					MM<_n> m1(m);
+					m1.Set(vars[j], 1);
+					cands.emplace(m1, std::make_pair(stairs.size() - 1, j));
+				}
+		}
+	}
+
+public:
+	//! Смена порядка
+	/*! По базису Гребнера gb строится редуцированный базис Гребнера
+		result того же идеала в порядке result.GetOrder().
+		\pre gb -- базис Гребнера. */
+	template<class _O2>
+	void Process(const _I& gb, MI<_n, _O2>& result)
+	{
+		result.SetEmpty();
+		_stat = _Stat();
+		if (gb.IsEmpty())
+			return;
+		// существенные переменные
+		std::vector<size_t> vars;
+		MM<_n> mon = gb.GatherVars();
+		for (size_t pos = 0; pos < _n; ++pos)
+			if (mon.Test(pos))
+				vars.push_back(pos);
+		// базис факторкольца
+		_P qb(gb.GetOrder());
+		_stat.dim = gb.QuotientBasis(qb);
+		_stat.sparse = _stat.dim >= _sparseDim;
+		if (_stat.sparse)
+			_Process<_Sparse>(gb, vars, qb, result);
+		else
+			_Process<_Dense>(gb, vars, qb, result);
+		result.Normalize();
+		_stat.polys = result.Size();
+	}
+
+	//! Порог разреженности
+	/*! Устанавливается наименьшая размерность факторкольца dim,
+		при которой векторы хранятся разреженно (4096 по умолчанию). */
+	void SetSparseDim(size_t dim)
+	{
+		_sparseDim = dim;
+	}
+
+	//! Статистика
+	const _Stat& GetStat() const
+	{
+		return _stat;
+	}
+
+	//! Конструктор
+	FGLM() : _sparseDim(4096)
+	{
+		_stat = _Stat();
+	}
+};
+
+} // namespace GF2
+
+#endif // __GF2_FGLM
@@ -4,7 +4,7 @@
 \brief Functions {0, 1}^n \to T
 \project GF2 [algebra over GF(2)]
 \created 2004.06.10
-\version 2020.05.27
+\version 2026.10.16
 \license This program is released under the MIT License. See Copyright Notices 
 in GF2/info.h.
 *******************************************************************************
@@ -28,6 +28,7 @@ in GF2/info.h.
 #define __GF2_FUNC
 
 #include "gf2/env.h"
+#include "gf2/eval.h"
 #include "gf2/mi.h"
 #include "gf2/ww.h"
 #include "gf2/zz.h"
@@ -384,12 +385,23 @@ public:
 	}
 
 	//! Построение многочлена по функции
-	/*! По многочлену Жегалкина polyRight определяется булева функция. */
+	/*! По многочлену Жегалкина polyRight определяется булева функция. 
+		\remark Многочлен вычисляется блоками по 8 * B_PER_W точек 
+		(см. Eval). */
 	void From(const MP<_n>& polyRight)
 	{	
-		Preimage x;
-		do Set(x, polyRight.Calc(x));			
-		while (x.Next());
+		Eval<_n> eval(polyRight);
+		Preimage points[8 * B_PER_W];
+		std::vector<word> res;
+		for (word x = 0, count; x < _size; x += count)
+		{
+			count = std::min<word>(_size - x, 8 * B_PER_W);
+			for (word i = 0; i < count; ++i)
+				points[i] = x + i;
+			eval.Calc(points, count, res);
+			for (word i = 0; i < count; ++i)
+				Set(x + i, (res[i / B_PER_W] >> i % B_PER_W & 1) != 0);
+		}
 	}
 
 	//! Преобразование Уолша -- Адамара
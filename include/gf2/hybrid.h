@@ -0,0 +1,352 @@
+/*
+*******************************************************************************
+\file hybrid.h
+\brief Hybrid guess-and-determine solver
+\project GF2 [algebra over GF(2)]
+\created 2026.10.17
+\version 2026.10.17
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file hybrid.h
+\brief Гибридное решение систем уравнений
+
+Модуль содержит описание и реализацию класса Hybrid, который решает системы
+уравнений, угадывая значения части переменных и вычисляя базисы Гребнера
+полученных систем.
+*******************************************************************************
+*/
+
+#ifndef __GF2_HYBRID
+#define __GF2_HYBRID
+
+#include "gf2/buchb.h"
+#include "gf2/mi.h"
+#include "gf2/pool.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс Hybrid
+
+Решение системы уравнений {p = 0: p in system} методом "угадай и определи"
+(guess-and-determine). Значения k существенных переменных системы, которые
+входят в наибольшее число мономов, угадываются. Для каждого из 2^k наборов
+значений a вычисляется базис Гребнера системы-ветви (алгоритм Buchb),
+по которому определяются решения.
+
+Наборы a перебираются в порядке кода Грея и делятся на отрезки, которые
+обрабатываются на исполнителях пула Pool. Исполнитель поддерживает
+сдвинутую систему system(x + a): при переходе к следующему набору
+меняется одна угадываемая переменная x_v, и в сдвинутой системе
+выполняется одна замена x_v -> x_v + 1 (см. MI::Replace()). Ветвь
+получается из сдвинутой системы удалением мономов, которые содержат
+угадываемые переменные.
+
+Ветвь отбрасывается, как только 1 попадает в базис Гребнера: оставшиеся
+критические пары не обрабатываются.
+
+Решения рассматриваются относительно существенных переменных системы
+(остальные переменные решений нулевые). По базису Гребнера ветви они
+определяются расщеплением: неугаданная переменная x_v, которая входит
+в базис, принимает значение c, если идеал базиса, дополненного
+многочленом x_v + c, не содержит 1. Переменная, которая не входит
+в базис, принимает оба значения.
+
+Решения передаются функции обратного вызова f(x). Вызовы f
+последовательны (выполняются под блокировкой), но их порядок не определен.
+
+\code
+	Pool pool;
+	Hybrid<n, O> hybrid(pool);
+	hybrid.SetGuess(k);
+	hybrid.Process(system, [&](const WW<n>& x) { ... });
+\endcode
+*******************************************************************************
+*/
+
+template<size_t _n, class _O> class Hybrid
+{
+protected:
+	typedef MI<_n, _O> _I;
+	typedef MP<_n, _O> _P;
+
+	//! Алгоритм Бухбергера с ранним прекращением
+	/*! Как только в базис попадает 1, вычисления прекращаются
+		(см. Buchb::Stop()) и устанавливается признак one. */
+	class _Buchb : public Buchb<_n, _O>
+	{
+	protected:
+		bool Validate(const _P& poly) override
+		{
+			if (poly == 1)
+				this->Stop(), one = true;
+			return true;
+		}
+
+	public:
+		bool one; //< 1 попала в базис
+
+		//! Базис Гребнера системы
+		/*! \return Признак того, что 1 не принадлежит идеалу. */
+		bool Process(const _I& system, _I& gb)
+		{
+			one = false;
+			this->Init();
+			this->Update(system);
+			this->Process();
+			this->Done(gb);
+			return !one;
+		}
+
+		//! Базис Гребнера расширенной системы
+		/*! Определяется базис Гребнера идеала, порожденного базисом
+			Гребнера basis и многочленом poly.
+			\return Признак того, что 1 не принадлежит идеалу. */
+		bool Process(const _I& basis, const _P& poly, _I& gb)
+		{
+			one = false;
+			this->Init(basis);
+			this->Update(poly);
+			this->Process();
+			this->Done(gb);
+			return !one;
+		}
+
+		using Buchb<_n, _O>::Process;
+	};
+
+	//! Статистика
+	struct _Stat
+	{
+		size_t guessed; //< число угадываемых переменных
+		size_t branches; //< число ветвей
+		size_t inconsistent; //< число несовместных ветвей
+		size_t solutions; //< число решений
+	};
+
+	Pool& _pool; // пул потоков
+	std::mutex _lock; // блокировка вызовов f
+	size_t _guess; // число угадываемых переменных
+	std::vector<size_t> _vars; // угадываемые переменные
+	_Stat _stat; // статистика
+
+	//! Перечисление решений
+	/*! Перечисляются решения системы gb (базис Гребнера) относительно
+		переменных rest[idx], rest[idx + 1],.... Значения остальных
+		переменных заданы в x. Решения передаются функции f.
+		\return Число решений. */
+	template<class _F>
+	size_t _Enum(_Buchb& bb, const _I& gb, const std::vector<size_t>& rest,
+		size_t idx, WW<_n>& x, _F& f)
+	{
+		if (idx == rest.size())
+		{
+			std::lock_guard<std::mutex> guard(_lock);
+			f(x);
+			return 1;
+		}
+		size_t v = rest[idx], count = 0;
+		// переменная не входит в базис?
+		if (!gb.GatherVars().Test(v))
+		{
+			for (size_t c = 0; c < 2; ++c)
+				x.Set(v, c != 0), count += _Enum(bb, gb, rest, idx + 1, x, f);
+			return count;
+		}
+		// расщепление
+		_I gb1;
+		for (size_t c = 0; c < 2; ++c)
+		{
+			_P poly(gb.GetOrder());
+			poly += MM<_n>(v);
+			if (c)
+				poly += 1;
+			if (bb.Process(gb, poly, gb1))
+				x.Set(v, c != 0), count += _Enum(bb, gb1, rest, idx + 1, x, f);
+		}
+		return count;
+	}
+
+	//! Обработка отрезка наборов
+	/*! Обрабатываются ветви для наборов значений угадываемых переменных
+		guess с номерами [begin, end) в коде Грея. Значения остальных
+		существенных переменных rest определяются по базисам Гребнера
+		ветвей. Решения передаются функции f.
+		\return Число решений. */
+	template<class _F>
+	size_t _Solve(const _I& system, const std::vector<size_t>& guess,
+		const std::vector<size_t>& rest, size_t begin, size_t end,
+		_Stat& stat, _F& f)
+	{
+		const _O& order = system.GetOrder();
+		// маска угадываемых переменных и многочлены x_v + 1
+		MM<_n> mask;
+		std::vector<_P> flips;
+		for (size_t j = 0; j < guess.size(); ++j)
+		{
+			mask.Set(guess[j], 1);
+			flips.emplace_back(order);
+			flips.back() += MM<_n>(guess[j]), flips.back() += 1;
+		}
+		// сдвинутая система system(x + a), a -- первый набор
+		size_t a = begin ^ (begin >> 1);
+		std::map<size_t, _P> shift;
+		for (size_t j = 0; j < guess.size(); ++j)
+			if (a >> j & 1)
+				shift.emplace(guess[j], flips[j]);
+		_I s(system);
+		if (!shift.empty())
+			s.Substitute(shift);
+		// перебор ветвей
+		_Buchb bb;
+		_I branch, gb;
+		WW<_n> x;
+		size_t count = 0;
+		for (size_t i = begin; i < end; ++i)
+		{
+			// следующий набор отличается одной переменной
+			if (i > begin)
+			{
+				size_t j = WordLoBit(word(i));
+				a ^= size_t(1) << j;
+				s.Replace(guess[j], flips[j]);
+			}
+			++stat.branches;
+			// ветвь: мономы без угадываемых переменных
+			branch.SetEmpty();
+			branch.SetOrder(order);
+			bool one = false;
+			for (auto iter = s.begin(); iter != s.end() && !one; ++iter)
+			{
+				_P poly(order);
+				for (auto m = iter->begin(); m != iter->end(); ++m)
+				{
+					size_t pos = 0;
+					while (pos < mask.WordSize() &&
+						(m->GetWord(pos) & mask.GetWord(pos)) == 0)
+						++pos;
+					if (pos == mask.WordSize())
+						poly.push_back(*m);
+				}
+				one = poly == 1;
+				if (poly != 0)
+					branch.insert(branch.end(), _P(order))->Swap(poly);
+			}
+			branch.Normalize();
+			if (one || !bb.Process(branch, gb))
+			{
+				++stat.inconsistent;
+				continue;
+			}
+			// решения ветви
+			for (size_t j = 0; j < guess.size(); ++j)
+				x.Set(guess[j], (a >> j & 1) != 0);
+			count += _Enum(bb, gb, rest, 0, x, f);
+		}
+		return count;
+	}
+
+public:
+	//! Решение
+	/*! Находятся все решения системы system. Каждое решение x передается
+		функции f(x).
+		\return Число решений. */
+	template<class _F>
+	size_t Process(const _I& system, _F&& f)
+	{
+		// существенные переменные и числа мономов, которые их содержат
+		std::vector<size_t> freq(_n, 0), vars;
+		for (auto iter = system.begin(); iter != system.end(); ++iter)
+			for (auto m = iter->begin(); m != iter->end(); ++m)
+				for (size_t pos = 0; pos < m->WordSize(); ++pos)
+					for (word w = m->GetWord(pos); w; w &= w - 1)
+						++freq[pos * B_PER_W + WordLoBit(w)];
+		for (size_t v = 0; v < _n; ++v)
+			if (freq[v])
+				vars.push_back(v);
+		// угадываемые переменные: входят в наибольшее число мономов
+		std::stable_sort(vars.begin(), vars.end(), [&](size_t v1, size_t v2)
+		{
+			return freq[v1] > freq[v2];
+		});
+		size_t k = std::min(std::min(_guess, vars.size()), size_t(B_PER_W - 1));
+		_vars.assign(vars.begin(), vars.begin() + k);
+		std::vector<size_t> rest(vars.begin() + k, vars.end());
+		std::sort(_vars.begin(), _vars.end());
+		std::sort(rest.begin(), rest.end());
+		// перебор по отрезкам
+		size_t count = size_t(1) << k;
+		size_t tasks = std::min(count, 4 * _pool.Size());
+		std::vector<_Stat> stats(tasks, _Stat());
+		_pool.Run(tasks, [&](size_t, size_t task)
+		{
+			stats[task].solutions = _Solve(system, _vars, rest,
+				count * task / tasks, count * (task + 1) / tasks,
+				stats[task], f);
+		});
+		_stat = _Stat();
+		_stat.guessed = k;
+		for (size_t task = 0; task < tasks; ++task)
+		{
+			_stat.branches += stats[task].branches;
+			_stat.inconsistent += stats[task].inconsistent;
+			_stat.solutions += stats[task].solutions;
+		}
+		return _stat.solutions;
+	}
+
+	//! Число угадываемых переменных
+	/*! Устанавливается число k угадываемых переменных (0 по умолчанию).
+		Если k превосходит число существенных переменных системы,
+		то угадываются все переменные. */
+	void SetGuess(size_t k)
+	{
+		_guess = k;
+	}
+
+	//! Угадываемые переменные
+	/*! Возвращаются переменные, значения которых угадывались
+		при последнем вызове Process(). */
+	const std::vector<size_t>& GetGuessVars() const
+	{
+		return _vars;
+	}
+
+	//! Статистика
+	const _Stat& GetStat() const
+	{
+		return _stat;
+	}
+
+	//! Печать статистики
+	void PrintStat() const
+	{
+		Env::Print(
+			"Hybrid: %zu variables guessed\n"
+			"        %zu branches (%zu inconsistent)\n"
+			"        %zu solutions\n",
+			_stat.guessed, _stat.branches, _stat.inconsistent,
+			_stat.solutions);
+	}
+
+	//! Конструктор
+	/*! Ветви обрабатываются на исполнителях пула pool. */
+	explicit Hybrid(Pool& pool) : _pool(pool), _guess(0)
+	{
+		_stat = _Stat();
+	}
+};
+
+} // namespace GF2
+
+#endif // __GF2_HYBRID
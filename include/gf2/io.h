@@ -0,0 +1,884 @@
+/*
+*******************************************************************************
+\file io.h
+\brief Binary and bulk text input/output of words, monomials, polynomials
+and ideals
+\project GF2 [algebra over GF(2)]
+\created 2026.10.16
+\version 2026.10.16
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file io.h
+\brief Двоичный и текстовый ввод-вывод
+
+Модуль содержит средства сохранения в компактном двоичном формате и загрузки
+слов (WW), мономов (MM), многочленов (MP) и систем многочленов (MI), а также
+средства быстрого разбора и форматирования текстового представления MP и MI.
+
+Двоичное представление объекта начинается с заголовка:
+-	магическое число 0x42324647 ("GF2B");
+-	номер версии формата (1);
+-	тип объекта (BIN_WW, BIN_MM, BIN_MP, BIN_MI);
+-	число переменных _n;
+-	длина машинного слова в битах (B_PER_W);
+-	идентификатор мономиального порядка (_O::id, 0 для WW и MM);
+-	длина данных-параметров порядка в октетах;
+-	данные-параметры порядка (октеты объекта _O; пусто для порядков
+	без параметров).
+Все числовые поля заголовка имеют тип u32.
+
+За заголовком следует тело:
+-	WW, MM: машинные слова;
+-	MP: число мономов (u64), затем машинные слова экспонент всех мономов;
+-	MI: число многочленов (u64), числа мономов в каждом из многочленов
+	(u64), затем машинные слова экспонент всех мономов всех многочленов.
+
+Машинные слова и числа записываются в порядке байтов платформы.
+Файл, записанный на платформе с другим порядком байтов или другой длиной
+машинного слова, не загружается (не совпадают магическое число или B_PER_W).
+
+Запись выполняется через буферизованный поток BinWriter. Чтение выполняется
+через поток BinReader, который отображает файл в память (mmap), а на
+платформах без mmap читает файл целиком. Мономы копируются в MP / MI прямо
+из отображенной памяти.
+
+При загрузке MP / MI объект сохраняет свой мономиальный порядок. Если порядок
+в файле совпадает с порядком объекта (совпадают идентификаторы и параметры),
+то мономы и многочлены уже упорядочены и нормализация не выполняется
+(проверяется только упорядоченность). Иначе загруженные многочлены и системы
+нормализуются.
+
+Текстовый формат совпадает с форматом операторов ввода-вывода в поток
+(см. mm.h, mp.h, mi.h). Функции Parse() разбирают текст, размещенный в
+памяти, функции LoadText() -- текст, размещенный в файле (файл отображается
+в память с помощью BinReader). При разборе многочлена мономы накапливаются
+в плоском буфере, который сортируется один раз, после чего одинаковые мономы
+взаимно уничтожаются. Система многочленов нормализуется один раз после
+разбора всех многочленов. Функции Format() дописывают текстовое
+представление объектов в строку без обращения к std::ostream, функции
+SaveText() сохраняют его в файле.
+*******************************************************************************
+*/
+
+#ifndef __GF2_IO
+#define __GF2_IO
+
+#include "gf2/defs.h"
+#include "gf2/mi.h"
+#include <cstdio>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#ifdef OS_UNIX
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс BinWriter
+
+Буферизованная запись в двоичный файл. Ошибки записи накапливаются: после
+первой ошибки все последующие операции завершаются неудачей, а итоговый
+признак успеха возвращает Close().
+*******************************************************************************
+*/
+
+class BinWriter
+{
+	std::FILE* _fp; //< файл
+	std::vector<octet> _buf; //< буфер
+	size_t _pos; //< число октетов в буфере
+	bool _ok; //< признак отсутствия ошибок
+public:
+	//! Открыть
+	/*! Открывается (создается) файл path.
+		\return Признак успеха. */
+	bool Open(const char* path)
+	{
+		Close();
+		_fp = std::fopen(path, "wb");
+		_pos = 0;
+		return _ok = (_fp != 0);
+	}
+
+	//! Записать
+	/*! Записываются count октетов буфера buf.
+		\return Признак успеха. */
+	bool Write(const void* buf, size_t count)
+	{
+		if (!_ok)
+			return false;
+		// не помещается в буфер?
+		if (_pos + count > _buf.size())
+		{
+			if (!Flush())
+				return false;
+			if (count > _buf.size())
+				return _ok = std::fwrite(buf, 1, count, _fp) == count;
+		}
+		std::memcpy(_buf.data() + _pos, buf, count);
+		_pos += count;
+		return true;
+	}
+
+	//! Записать
+	/*! Записывается значение val простого типа.
+		\return Признак успеха. */
+	template<class _T> bool Write(const _T& val)
+	{
+		static_assert(std::is_trivially_copyable<_T>::value,
+			"BinWriter::Write: trivially copyable type expected");
+		return Write(&val, sizeof(_T));
+	}
+
+	//! Сбросить буфер
+	/*! Содержимое буфера записывается в файл.
+		\return Признак успеха. */
+	bool Flush()
+	{
+		if (_ok && _pos)
+			_ok = std::fwrite(_buf.data(), 1, _pos, _fp) == _pos;
+		_pos = 0;
+		return _ok;
+	}
+
+	//! Закрыть
+	/*! Буфер сбрасывается, файл закрывается.
+		\return Признак того, что все операции записи были успешными. */
+	bool Close()
+	{
+		if (!_fp)
+			return false;
+		Flush();
+		_ok = (std::fclose(_fp) == 0) && _ok;
+		_fp = 0;
+		return _ok;
+	}
+
+	//! Нет ошибок?
+	bool IsOK() const
+	{
+		return _ok;
+	}
+
+	//! Конструктор
+	BinWriter() : _fp(0), _buf(size_t(1) << 16), _pos(0), _ok(false) {}
+
+	//! Деструктор
+	~BinWriter()
+	{
+		Close();
+	}
+
+	BinWriter(const BinWriter&) = delete;
+	BinWriter& operator=(const BinWriter&) = delete;
+};
+
+/*!
+*******************************************************************************
+Класс BinReader
+
+Чтение из двоичного файла. Файл отображается в память (mmap), а при
+отсутствии такой возможности читается в память целиком. Метод Get()
+возвращает указатель на очередной фрагмент данных без копирования.
+*******************************************************************************
+*/
+
+class BinReader
+{
+	const octet* _data; //< данные
+	size_t _size; //< длина данных
+	size_t _pos; //< текущая позиция
+	std::vector<octet> _buf; //< данные без отображения
+	void* _map; //< отображение
+	bool _ok; //< признак отсутствия ошибок
+public:
+	//! Открыть
+	/*! Открывается файл path.
+		\return Признак успеха. */
+	bool Open(const char* path)
+	{
+		Close();
+#ifdef OS_UNIX
+		int fd = ::open(path, O_RDONLY);
+		if (fd >= 0)
+		{
+			struct stat st;
+			if (::fstat(fd, &st) == 0 && st.st_size > 0)
+			{
+				void* map = ::mmap(0, size_t(st.st_size), PROT_READ,
+					MAP_PRIVATE, fd, 0);
+				if (map != MAP_FAILED)
+				{
+					_map = map;
+					_data = static_cast<const octet*>(map);
+					_size = size_t(st.st_size);
+				}
+			}
+			::close(fd);
+			if (_map)
+				return _ok = true;
+		}
+#endif
+		// чтение целиком
+		std::FILE* fp = std::fopen(path, "rb");
+		if (!fp)
+			return false;
+		octet buf[4096];
+		for (size_t count; (count = std::fread(buf, 1, sizeof(buf), fp)) > 0;)
+			_buf.insert(_buf.end(), buf, buf + count);
+		_ok = !std::ferror(fp);
+		std::fclose(fp);
+		_data = _buf.data(), _size = _buf.size();
+		return _ok;
+	}
+
+	//! Получить
+	/*! Возвращается указатель на очередные count октетов данных.
+		\return Указатель на данные или 0, если данных недостаточно. */
+	const void* Get(size_t count)
+	{
+		if (!_ok || count > _size - _pos)
+			return (_ok = false), nullptr;
+		const octet* ptr = _data + _pos;
+		_pos += count;
+		return ptr;
+	}
+
+	//! Прочитать
+	/*! Очередные count октетов данных копируются в буфер buf.
+		\return Признак успеха. */
+	bool Read(void* buf, size_t count)
+	{
+		const void* ptr = Get(count);
+		if (ptr)
+			std::memcpy(buf, ptr, count);
+		return ptr != 0;
+	}
+
+	//! Прочитать
+	/*! Читается значение val простого типа.
+		\return Признак успеха. */
+	template<class _T> bool Read(_T& val)
+	{
+		static_assert(std::is_trivially_copyable<_T>::value,
+			"BinReader::Read: trivially copyable type expected");
+		return Read(&val, sizeof(_T));
+	}
+
+	//! Число непрочитанных октетов
+	size_t Left() const
+	{
+		return _size - _pos;
+	}
+
+	//! Закрыть
+	void Close()
+	{
+#ifdef OS_UNIX
+		if (_map)
+			::munmap(_map, _size);
+#endif
+		_map = 0, _data = 0, _size = _pos = 0, _ok = false;
+		std::vector<octet>().swap(_buf);
+	}
+
+	//! Нет ошибок?
+	bool IsOK() const
+	{
+		return _ok;
+	}
+
+	//! Конструктор
+	BinReader() : _data(0), _size(0), _pos(0), _map(0), _ok(false) {}
+
+	//! Деструктор
+	~BinReader()
+	{
+		Close();
+	}
+
+	BinReader(const BinReader&) = delete;
+	BinReader& operator=(const BinReader&) = delete;
+};
+
+/*
+*******************************************************************************
+Заголовок
+*******************************************************************************
+*/
+
+//! Типы объектов
+enum BinKind : u32
+{
+	BIN_WW = 1,
+	BIN_MM = 2,
+	BIN_MP = 3,
+	BIN_MI = 4,
+};
+
+//! Запись заголовка
+/*! Записывается заголовок объекта типа kind от _n переменных с порядком
+	order. Для WW и MM порядок не используется (_O = void). */
+template<size_t _n, class _O = void>
+bool BinWriteHeader(BinWriter& w, BinKind kind, const _O* order = 0)
+{
+	u32 header[7] = { 0x42324647, 1, kind, u32(_n), B_PER_W, 0, 0 };
+	if constexpr (!std::is_void<_O>::value)
+	{
+		static_assert(std::is_trivially_copyable<_O>::value,
+			"BinWriteHeader: trivially copyable order expected");
+		header[5] = _O::id;
+		header[6] = std::is_empty<_O>::value ? 0 : u32(sizeof(_O));
+	}
+	w.Write(header, sizeof(header));
+	if (header[6])
+		w.Write(order, header[6]);
+	return w.IsOK();
+}
+
+//! Чтение заголовка
+/*! Читается и проверяется заголовок объекта типа kind от _n переменных.
+	В match возвращается признак совпадения порядка в файле с порядком
+	order. */
+template<size_t _n, class _O = void>
+bool BinReadHeader(BinReader& r, BinKind kind, const _O* order = 0,
+	bool* match = 0)
+{
+	u32 header[7];
+	if (!r.Read(header, sizeof(header)) ||
+		header[0] != 0x42324647 || header[1] != 1 || header[2] != kind ||
+		header[3] != u32(_n) || header[4] != B_PER_W)
+		return false;
+	const void* params = r.Get(header[6]);
+	if (!params)
+		return false;
+	if constexpr (!std::is_void<_O>::value)
+	{
+		*match = false;
+		if (header[5] == _O::id)
+		{
+			if (std::is_empty<_O>::value)
+				*match = (header[6] == 0);
+			else if (header[6] == sizeof(_O))
+			{
+				_O o;
+				std::memcpy(static_cast<void*>(&o), params, sizeof(_O));
+				*match = (o == *order);
+			}
+		}
+	}
+	return true;
+}
+
+/*
+*******************************************************************************
+Мономы
+*******************************************************************************
+*/
+
+//! Запись мономов
+/*! Записываются машинные слова экспонент мономов poly. */
+template<size_t _n, class _O>
+bool BinWriteMons(BinWriter& w, const MP<_n, _O>& poly)
+{
+	word buf[(_n + B_PER_W - 1) / B_PER_W];
+	for (auto iter = poly.begin(); iter != poly.end(); ++iter)
+	{
+		for (size_t pos = 0; pos < MM<_n>::WordSize(); ++pos)
+			buf[pos] = iter->GetWord(pos);
+		w.Write(buf, sizeof(buf));
+	}
+	return w.IsOK();
+}
+
+//! Чтение мономов
+/*! Читаются машинные слова экспонент count мономов. Мономы добавляются в
+	конец poly без нормализации. Проверяется, что биты дополнения в
+	последних словах экспонент нулевые. */
+template<size_t _n, class _O>
+bool BinReadMons(BinReader& r, MP<_n, _O>& poly, u64 count)
+{
+	const size_t size = MM<_n>::WordSize() * sizeof(word);
+	if (count > r.Left() / size)
+		return false;
+	const octet* ptr = static_cast<const octet*>(r.Get(size_t(count) * size));
+	if (!ptr)
+		return false;
+	const word tail = _n % B_PER_W ?
+		WORD_MAX << _n % B_PER_W : word(0);
+	for (MM<_n> m; count--; poly.push_back(m))
+	{
+		word w;
+		for (size_t pos = 0; pos < MM<_n>::WordSize(); ++pos)
+		{
+			std::memcpy(&w, ptr, sizeof(word));
+			ptr += sizeof(word);
+			m.SetWord(pos, w);
+		}
+		if (w & tail)
+			return false;
+	}
+	return true;
+}
+
+/*
+*******************************************************************************
+Сохранение
+*******************************************************************************
+*/
+
+//! Сохранение слова
+/*! Слово wRight записывается в поток w. */
+template<size_t _n>
+bool Save(BinWriter& w, const WW<_n>& wRight)
+{
+	BinWriteHeader<_n>(w, BIN_WW);
+	for (size_t pos = 0; pos < wRight.WordSize(); ++pos)
+		w.Write(wRight.GetWord(pos));
+	return w.IsOK();
+}
+
+//! Сохранение монома
+/*! Моном mRight записывается в поток w. */
+template<size_t _n>
+bool Save(BinWriter& w, const MM<_n>& mRight)
+{
+	BinWriteHeader<_n>(w, BIN_MM);
+	for (size_t pos = 0; pos < mRight.WordSize(); ++pos)
+		w.Write(mRight.GetWord(pos));
+	return w.IsOK();
+}
+
+//! Сохранение многочлена
+/*! Многочлен polyRight записывается в поток w. */
+template<size_t _n, class _O>
+bool Save(BinWriter& w, const MP<_n, _O>& polyRight)
+{
+	BinWriteHeader<_n>(w, BIN_MP, &polyRight.GetOrder());
+	w.Write(u64(polyRight.Size()));
+	return BinWriteMons(w, polyRight);
+}
+
+//! Сохранение системы
+/*! Система iRight записывается в поток w. */
+template<size_t _n, class _O>
+bool Save(BinWriter& w, const MI<_n, _O>& iRight)
+{
+	BinWriteHeader<_n>(w, BIN_MI, &iRight.GetOrder());
+	w.Write(u64(iRight.Size()));
+	for (auto iter = iRight.begin(); iter != iRight.end(); ++iter)
+		w.Write(u64(iter->Size()));
+	for (auto iter = iRight.begin(); iter != iRight.end(); ++iter)
+		BinWriteMons(w, *iter);
+	return w.IsOK();
+}
+
+//! Сохранение в файл
+/*! Объект obj (WW, MM, MP или MI) записывается в файл path.
+	\return Признак успеха. */
+template<class _T>
+bool Save(const char* path, const _T& obj)
+{
+	BinWriter w;
+	return w.Open(path) && Save(w, obj) && w.Close();
+}
+
+/*
+*******************************************************************************
+Загрузка
+*******************************************************************************
+*/
+
+//! Загрузка слова
+/*! Слово wRight читается из потока r. */
+template<size_t _n>
+bool Load(BinReader& r, WW<_n>& wRight)
+{
+	if (!BinReadHeader<_n>(r, BIN_WW))
+		return false;
+	word w;
+	for (size_t pos = 0; pos < wRight.WordSize(); ++pos)
+		if (r.Read(w))
+			wRight.SetWord(pos, w);
+	return r.IsOK() && (_n % B_PER_W == 0 || (w >> _n % B_PER_W) == 0);
+}
+
+//! Загрузка монома
+/*! Моном mRight читается из потока r. */
+template<size_t _n>
+bool Load(BinReader& r, MM<_n>& mRight)
+{
+	if (!BinReadHeader<_n>(r, BIN_MM))
+		return false;
+	word w;
+	for (size_t pos = 0; pos < mRight.WordSize(); ++pos)
+		if (r.Read(w))
+			mRight.SetWord(pos, w);
+	return r.IsOK() && (_n % B_PER_W == 0 || (w >> _n % B_PER_W) == 0);
+}
+
+//! Загрузка многочлена
+/*! Многочлен polyRight читается из потока r. Порядок polyRight
+	сохраняется. */
+template<size_t _n, class _O>
+bool Load(BinReader& r, MP<_n, _O>& polyRight)
+{
+	bool match;
+	u64 count;
+	if (!BinReadHeader<_n>(r, BIN_MP, &polyRight.GetOrder(), &match) ||
+		!r.Read(count))
+		return false;
+	polyRight.SetEmpty();
+	if (!BinReadMons(r, polyRight, count))
+		return false;
+	if (!match || !polyRight.IsNormalized())
+		polyRight.Normalize();
+	return true;
+}
+
+//! Загрузка системы
+/*! Система iRight читается из потока r. Порядок iRight сохраняется. */
+template<size_t _n, class _O>
+bool Load(BinReader& r, MI<_n, _O>& iRight)
+{
+	bool match;
+	u64 count;
+	if (!BinReadHeader<_n>(r, BIN_MI, &iRight.GetOrder(), &match) ||
+		!r.Read(count) || count > r.Left() / sizeof(u64))
+		return false;
+	const octet* sizes = static_cast<const octet*>(r.Get(
+		size_t(count) * sizeof(u64)));
+	iRight.SetEmpty();
+	for (; sizes && count--; sizes += sizeof(u64))
+	{
+		u64 size;
+		std::memcpy(&size, sizes, sizeof(u64));
+		auto iter = iRight.insert(iRight.end(), MP<_n, _O>(iRight.GetOrder()));
+		if (!BinReadMons(r, *iter, size))
+			return false;
+		if (!match || !iter->IsNormalized())
+			iter->Normalize();
+	}
+	if (!r.IsOK())
+		return false;
+	if (!match || !iRight.IsNormalized())
+		iRight.Normalize();
+	return true;
+}
+
+//! Загрузка из файла
+/*! Объект obj (WW, MM, MP или MI) читается из файла path.
+	\return Признак успеха. */
+template<class _T>
+bool Load(const char* path, _T& obj)
+{
+	BinReader r;
+	return r.Open(path) && Load(r, obj);
+}
+
+/*
+*******************************************************************************
+Разбор текста
+*******************************************************************************
+*/
+
+//! Пропуск пустых символов
+/*! Указатель ptr продвигается вперед до первого символа, который не входит 
+	в набор " \n\r\t\v", но не дальше end. */
+inline void TextSkip(const char*& ptr, const char* end)
+{
+	for (; ptr < end; ++ptr)
+		if (*ptr != ' ' && *ptr != '\n' && *ptr != '\r' && *ptr != '\t' && 
+			*ptr != '\v')
+			break;
+}
+
+//! Разбор монома
+/*! Из текста [ptr, end) читается моном m. Пустые символы перед мономом 
+	пропускаются. При успехе ptr указывает на первый символ после монома. 
+	\return Признак успеха. Правила разбора -- как в operator>>(MM). */
+template<size_t _n>
+bool Parse(const char*& ptr, const char* end, MM<_n>& m)
+{
+	m.SetAll(0);
+	TextSkip(ptr, end);
+	if (ptr < end && *ptr == '1')
+		return ++ptr, true;
+	if (ptr == end || *ptr != 'x')
+		return false;
+	while (true)
+	{
+		// индекс переменной
+		size_t index = 0;
+		const char* digits = ++ptr;
+		for (; ptr < end && '0' <= *ptr && *ptr <= '9'; ++ptr)
+			if ((index = index * 10 + size_t(*ptr - '0')) >= _n)
+				return false;
+		if (ptr == digits || m.Test(index))
+			return false;
+		m.Set(index, 1);
+		// следующая переменная (обязательно после разделителя)?
+		const char* next = ptr;
+		TextSkip(next, end);
+		if (next == end || *next != 'x')
+			return true;
+		if (next == ptr)
+			return false;
+		ptr = next;
+	}
+}
+
+//! Разбор многочлена
+/*! Из текста [ptr, end) читается многочлен polyRight. Мономы собираются 
+	в буфере mons, который затем сортируется, после чего одинаковые мономы 
+	взаимно уничтожаются. При успехе ptr указывает на первый символ после 
+	многочлена. 
+	\return Признак успеха. Правила разбора -- как в operator>>(MP). */
+template<size_t _n, class _O>
+bool Parse(const char*& ptr, const char* end, MP<_n, _O>& polyRight,
+	std::vector<MM<_n>>& mons)
+{
+	mons.clear();
+	polyRight.SetEmpty();
+	while (true)
+	{
+		// лексема
+		TextSkip(ptr, end);
+		if (ptr < end && *ptr == '0')
+			++ptr;
+		else
+		{
+			mons.emplace_back();
+			if (!Parse(ptr, end, mons.back()))
+				return false;
+		}
+		// знак +?
+		const char* next = ptr;
+		TextSkip(next, end);
+		if (next == end || *next != '+')
+			break;
+		ptr = next + 1;
+	}
+	// сортировка по убыванию и взаимное уничтожение
+	const _O& order = polyRight.GetOrder();
+	std::sort(mons.begin(), mons.end(), [&order](const MM<_n>& m1, 
+		const MM<_n>& m2) { return order.Compare(m1, m2) > 0; });
+	for (size_t pos = 0; pos < mons.size();)
+	{
+		size_t next = pos + 1;
+		while (next < mons.size() && mons[next] == mons[pos])
+			++next;
+		if ((next - pos) & 1)
+			polyRight.push_back(mons[pos]);
+		pos = next;
+	}
+	return true;
+}
+
+//! Разбор многочлена
+/*! Из текста [ptr, end) читается многочлен polyRight. */
+template<size_t _n, class _O>
+bool Parse(const char*& ptr, const char* end, MP<_n, _O>& polyRight)
+{
+	std::vector<MM<_n>> mons;
+	return Parse(ptr, end, polyRight, mons);
+}
+
+//! Разбор системы
+/*! Из текста [ptr, end) читается система iRight. Система нормализуется 
+	один раз после разбора всех многочленов. При успехе ptr указывает на 
+	первый символ после закрывающей скобки. 
+	\return Признак успеха. Правила разбора -- как в operator>>(MI). */
+template<size_t _n, class _O>
+bool Parse(const char*& ptr, const char* end, MI<_n, _O>& iRight)
+{
+	iRight.SetEmpty();
+	TextSkip(ptr, end);
+	if (ptr == end || *ptr != '{')
+		return false;
+	TextSkip(++ptr, end);
+	if (ptr < end && *ptr == '}')
+		return ++ptr, true;
+	std::vector<MM<_n>> mons;
+	while (true)
+	{
+		auto iter = iRight.insert(iRight.end(), MP<_n, _O>(iRight.GetOrder()));
+		if (!Parse(ptr, end, *iter, mons))
+			return iRight.SetEmpty(), false;
+		TextSkip(ptr, end);
+		if (ptr < end && *ptr == ',')
+			++ptr;
+		else if (ptr < end && *ptr == '}')
+			break;
+		else
+			return iRight.SetEmpty(), false;
+	}
+	++ptr;
+	iRight.Normalize();
+	return true;
+}
+
+//! Загрузка текста
+/*! Объект obj (MM, MP или MI) читается из текстового файла path. 
+	\return Признак успеха. */
+template<class _T>
+bool LoadText(const char* path, _T& obj)
+{
+	BinReader r;
+	if (!r.Open(path))
+		return false;
+	size_t size = r.Left();
+	const char* ptr = static_cast<const char*>(r.Get(size));
+	return ptr && Parse(ptr, ptr + size, obj);
+}
+
+/*
+*******************************************************************************
+Форматирование текста
+*******************************************************************************
+*/
+
+//! Имена переменных
+/*! Таблица строк " x0", " x1",..., " x{n-1}", которая строится один раз 
+	и используется при форматировании мономов. */
+template<size_t _n> class TextNames
+{
+	char _names[_n][16]; //< имена (с ведущим пробелом)
+	u8 _lens[_n]; //< длины имен
+	//! Конструктор
+	TextNames()
+	{
+		for (size_t i = 0; i < _n; ++i)
+		{
+			char buf[24];
+			char* ptr = buf + sizeof(buf);
+			size_t index = i;
+			do *--ptr = char('0' + index % 10); while (index /= 10);
+			*--ptr = 'x', *--ptr = ' ';
+			_lens[i] = u8(buf + sizeof(buf) - ptr);
+			std::memcpy(_names[i], ptr, _lens[i]);
+		}
+	}
+public:
+	//! Максимальная длина имени (с ведущим пробелом)
+	static constexpr size_t maxlen = 12;
+
+	//! Запись имени
+	/*! Имя переменной x_i записывается по адресу ptr. Если first, то 
+		ведущий пробел пропускается. 
+		\return Адрес, следующий за записанным именем. */
+	char* Put(char* ptr, size_t i, bool first) const
+	{
+		std::memcpy(ptr, _names[i] + first, maxlen);
+		return ptr + _lens[i] - first;
+	}
+
+	//! Таблица имен
+	static const TextNames& Get()
+	{
+		static const TextNames names;
+		return names;
+	}
+};
+
+//! Запись монома
+/*! Текстовое представление монома m записывается по адресу ptr. 
+	\pre По адресу ptr можно записать m.Deg() * TextNames<_n>::maxlen + 1
+	символов.
+	\return Адрес, следующий за записанным мономом. */
+template<size_t _n>
+char* TextPut(char* ptr, const MM<_n>& m)
+{
+	const TextNames<_n>& names = TextNames<_n>::Get();
+	bool first = true;
+	for (size_t i = 0; i < m.WordSize(); ++i)
+		for (word w = m.GetWord(i); w; w &= w - 1)
+			ptr = names.Put(ptr, i * B_PER_W + WordLoBit(w), first),
+			first = false;
+	if (first)
+		*ptr++ = '1';
+	return ptr;
+}
+
+//! Форматирование монома
+/*! Текстовое представление монома m дописывается в str. */
+template<size_t _n>
+void Format(std::string& str, const MM<_n>& m)
+{
+	size_t size = str.size();
+	str.resize(size + m.Weight() * TextNames<_n>::maxlen + 1);
+	str.resize(TextPut(&str[size], m) - str.data());
+}
+
+//! Форматирование многочлена
+/*! Текстовое представление многочлена polyRight дописывается в str. 
+	Мономы записываются прямо в память str, которая при необходимости 
+	расширяется вдвое. */
+template<size_t _n, class _O>
+void Format(std::string& str, const MP<_n, _O>& polyRight)
+{
+	if (polyRight.IsEmpty())
+	{
+		str += '0';
+		return;
+	}
+	size_t pos = str.size();
+	for (auto iter = polyRight.begin(); iter != polyRight.end(); ++iter)
+	{
+		// расширение
+		size_t len = iter->Weight() * TextNames<_n>::maxlen + 4;
+		if (str.size() - pos < len)
+			str.resize(std::max(2 * str.size(), pos + len));
+		// запись
+		char* ptr = &str[pos];
+		if (iter != polyRight.begin())
+			*ptr++ = ' ', *ptr++ = '+', *ptr++ = ' ';
+		pos = TextPut(ptr, *iter) - str.data();
+	}
+	str.resize(pos);
+}
+
+//! Форматирование системы
+/*! Текстовое представление системы iRight дописывается в str. */
+template<size_t _n, class _O>
+void Format(std::string& str, const MI<_n, _O>& iRight)
+{
+	bool waitfirst = true;
+	for (auto iter = iRight.begin(); iter != iRight.end(); ++iter)
+	{
+		str.append(waitfirst ? "{\n  " : ",\n  ", 4);
+		Format(str, *iter);
+		waitfirst = false;
+	}
+	str += waitfirst ? "{}\n" : "\n}\n";
+}
+
+//! Сохранение текста
+/*! Текстовое представление объекта obj (MM, MP или MI) сохраняется 
+	в файле path.
+	\return Признак успеха. */
+template<class _T>
+bool SaveText(const char* path, const _T& obj)
+{
+	std::string str;
+	Format(str, obj);
+	BinWriter w;
+	return w.Open(path) && w.Write(str.data(), str.size()) && w.Close();
+}
+
+} // namespace GF2
+
+#endif // __GF2_IO
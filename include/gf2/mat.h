@@ -0,0 +1,538 @@
+/*
+*******************************************************************************
+\file mat.h
+\brief Dense matrices over GF(2)
+\project GF2 [algebra over GF(2)]
+\created 2026.10.16
+\version 2026.10.16
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file mat.h
+\brief Плотные матрицы над GF(2)
+
+Модуль содержит описание и реализацию класса Mat -- плотной матрицы
+над двоичным полем.
+*******************************************************************************
+*/
+
+#ifndef __GF2_MAT
+#define __GF2_MAT
+
+#include "gf2/pool.h"
+#include "gf2/ww.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс Mat
+
+Плотная матрица над GF(2), размеры которой задаются при выполнении.
+
+Строки хранятся подряд как массивы машинных слов той же структуры, что
+и в WW: элемент (i, j) -- это бит j % B_PER_W слова j / B_PER_W строки i.
+Поэтому строки легко обмениваются со словами WW (см. SetRow(), GetRow()).
+Неиспользуемые старшие биты последнего слова строки нулевые.
+
+Приведение к ступенчатому виду (Echelon()) выполняется методом четырех
+русских (M4RI, Bard, 2006). Столбцы обрабатываются полосами по 32.
+В полосе находится до 32 опорных строк. При поиске строки просматриваются
+один раз и приводятся только в пределах полосы (одного слова), а вместо
+сложения остальных слов запоминается комбинация исходных опорных строк.
+Поэтому поиск не зависит от длины строк, в том числе на полосах без
+опорных столбцов. Исходные опорные строки делятся на 4 группы по 8,
+и для каждой группы строится таблица всех 256 линейных комбинаций
+ее строк (в порядке кода Грея, по одному сложению строк на комбинацию).
+Затем каждая строка матрицы, в том числе опорная, приводится 
+4 сложениями с комбинациями, которые определяются битами строки
+в опорных столбцах (и запомненными комбинациями). Таким образом,
+матрица просматривается один раз на 32 столбца. Строки приводятся
+группами по 128. Внутри группы столбцы обходятся блоками по 512 слов,
+чтобы строки группы и соответствующие части таблиц оставались в кэше.
+Группы строк могут обрабатываться на исполнителях пула Pool. Сложения
+строк -- циклы по словам без ветвлений, которые компилятор объединяет
+в векторные операции.
+*******************************************************************************
+*/
+
+class Mat
+{
+	size_t _rows; //< число строк
+	size_t _cols; //< число столбцов
+	size_t _stride; //< число слов в строке
+	std::vector<word> _data; //< строки
+
+	//! Число опорных строк на таблицу
+	static constexpr size_t _k = 8;
+	//! Число таблиц на полосу
+	static constexpr size_t _t = 4;
+	//! Число строк в группе
+	static constexpr size_t _chunk = 128;
+	//! Число слов в блоке столбцов
+	static constexpr size_t _block = 512;
+
+	//! Сложение строк
+	/*! Выполняется dst ^= src для count слов. */
+	static void _Xor(word* dst, const word* src, size_t count)
+	{
+		size_t pos = 0;
+		// по 4 слова: все чтения предшествуют записям, поэтому 
+		// компилятор может объединить слова в векторные операции
+		for (; pos + 4 <= count; pos += 4)
+		{
+			word w[4];
+			for (size_t k = 0; k < 4; ++k)
+				w[k] = dst[pos + k] ^ src[pos + k];
+			for (size_t k = 0; k < 4; ++k)
+				dst[pos + k] = w[k];
+		}
+		for (; pos < count; ++pos)
+			dst[pos] ^= src[pos];
+	}
+
+	//! Сложение строк
+	/*! Выполняется dst ^= src[0] ^ ... ^ src[_t - 1] для count слов. */
+	static void _Xor(word* dst, const word* const src[_t], size_t count)
+	{
+		static_assert(_t == 4, "Mat: unexpected number of tables");
+		const word* s0 = src[0], * s1 = src[1], * s2 = src[2], * s3 = src[3];
+		size_t pos = 0;
+		for (; pos + 4 <= count; pos += 4)
+		{
+			word w[4];
+			for (size_t k = 0; k < 4; ++k)
+				w[k] = dst[pos + k] ^ s0[pos + k] ^ s1[pos + k] ^ 
+					s2[pos + k] ^ s3[pos + k];
+			for (size_t k = 0; k < 4; ++k)
+				dst[pos + k] = w[k];
+		}
+		for (; pos < count; ++pos)
+			dst[pos] ^= s0[pos] ^ s1[pos] ^ s2[pos] ^ s3[pos];
+	}
+
+	//! Бит строки
+	static bool _Test(const word* row, size_t col)
+	{
+		return (row[col / B_PER_W] >> col % B_PER_W & 1) != 0;
+	}
+
+	//! Полоса строки
+	/*! Определяются биты строки row в полосе из _k * _t столбцов,
+		которая начинается со столбца c. */
+	static uint32_t _Strip(const word* row, size_t c)
+	{
+		return uint32_t(row[c / B_PER_W] >> c % B_PER_W);
+	}
+
+	//! Приведение к ступенчатому виду
+	/*! Реализация методов Echelon(). Если pool != 0, то группы строк
+		обрабатываются на исполнителях *pool. */
+	size_t _Echelon(Pool* pool, bool reduced)
+	{
+		static_assert(_k * _t == 32 && B_PER_W % 32 == 0, 
+			"Mat: a strip must fit into a word");
+		std::vector<word> tables;
+		// опорные строки в порядке нахождения: биты в полосе, 
+		// комбинации исходных строк, номера по опорным столбцам
+		uint32_t strip[_k * _t], comb[_k * _t];
+		size_t order[_k * _t];
+		// комбинации по байтам битов полосы
+		uint32_t combs[_t][size_t(1) << _k];
+		size_t r = 0;
+		for (size_t c = 0; c < _cols && r < _rows; c += _k * _t)
+		{
+			const size_t width = std::min(_k * _t, _cols - c);
+			const size_t w0 = c / B_PER_W, len = _stride - w0;
+			// поиск опорных строк: строки просматриваются один раз
+			// и приводятся только в пределах полосы, приведение остальных 
+			// слов откладывается до сложения с таблицами
+			size_t found = 0;
+			uint32_t pivs = 0;
+			for (size_t p = r; p < _rows && found < width; ++p)
+			{
+				uint32_t s = _Strip(Row(p), c), m = 0;
+				// опорные строки приведены друг относительно друга,
+				// поэтому каждое сложение обнуляет один опорный бит
+				for (uint32_t x; (x = s & pivs) != 0;)
+				{
+					size_t j = order[WordLoBit(x)];
+					s ^= strip[j], m ^= comb[j];
+				}
+				if (s == 0)
+					continue;
+				size_t bit = WordLoBit(s);
+				SwapRows(p, r + found);
+				strip[found] = s, comb[found] = m ^ uint32_t(1) << found;
+				// исключаем бит из предыдущих опорных строк
+				for (size_t j = 0; j < found; ++j)
+					if (strip[j] >> bit & 1)
+						strip[j] ^= s, comb[j] ^= comb[found];
+				order[bit] = found++;
+				pivs |= uint32_t(1) << bit;
+			}
+			if (found == 0)
+				continue;
+			// таблицы комбинаций исходных опорных строк r + _k * g,...
+			const size_t groups = (found + _k - 1) / _k;
+			const size_t size = (size_t(1) << _k) * len;
+			tables.assign(groups * size, 0);
+			for (size_t g = 0; g < groups; ++g)
+			{
+				size_t count = size_t(1) << std::min(_k, found - _k * g);
+				word* table = tables.data() + g * size;
+				for (size_t i = 1; i < count; ++i)
+				{
+					word* dst = table + (i ^ (i >> 1)) * len;
+					const word* src = table + ((i - 1) ^ ((i - 1) >> 1)) * len;
+					std::copy(src, src + len, dst);
+					_Xor(dst, Row(r + _k * g + WordLoBit(i)) + w0, len);
+				}
+			}
+			// комбинации для битов полосы: бит опорного столбца 
+			// заменяется комбинацией его опорной строки
+			for (size_t g = 0; g < _t; ++g)
+			{
+				combs[g][0] = 0;
+				for (size_t i = 1; i < (size_t(1) << _k); ++i)
+				{
+					size_t bit = _k * g + WordLoBit(i);
+					combs[g][i] = combs[g][i & (i - 1)] ^ 
+						(pivs >> bit & 1 ? comb[order[bit]] : 0);
+				}
+			}
+			// сложение с комбинациями comb (при одной таблице -- 
+			// без обращений к нулевой комбинации)
+			auto combine = [&](word* dst, uint32_t comb, size_t b, 
+				size_t count)
+			{
+				if (groups == 1)
+				{
+					_Xor(dst, tables.data() + b + (comb & 255) * len, count);
+					return;
+				}
+				const word* src[_t];
+				for (size_t g = 0; g < _t; ++g)
+					src[g] = tables.data() + b + (g < groups ? 
+						g * size + (comb >> _k * g & 255) * len : 0);
+				_Xor(dst, src, count);
+			};
+			// опорные строки упорядочиваются по опорным столбцам
+			// и приводятся (исходные строки сохранены в таблицах)
+			for (size_t bit = 0, i = r; bit < width; ++bit)
+				if (pivs >> bit & 1)
+				{
+					word* row = Row(i++) + w0;
+					std::fill(row, row + len, 0);
+					combine(row, comb[order[bit]], 0, len);
+				}
+			// приведение групп строк
+			const size_t first = reduced ? 0 : r + found;
+			const size_t tasks = (_rows - first + _chunk - 1) / _chunk;
+			auto apply = [&](size_t, size_t task)
+			{
+				size_t begin = first + task * _chunk;
+				size_t end = std::min(_rows, begin + _chunk);
+				// комбинации исходных опорных строк
+				uint32_t index[_chunk];
+				for (size_t i = begin; i < end; ++i)
+				{
+					index[i - begin] = 0;
+					if (i >= r && i < r + found)
+						continue;
+					uint32_t s = _Strip(Row(i), c) & pivs;
+					for (size_t g = 0; g < _t; ++g)
+						index[i - begin] ^= combs[g][s >> _k * g & 255];
+				}
+				// сложение по блокам столбцов (отсутствующие группы
+				// представлены нулевой комбинацией первой таблицы)
+				for (size_t b = 0; b < len; b += _block)
+				{
+					size_t count = std::min(_block, len - b);
+					for (size_t i = begin; i < end; ++i)
+						if (index[i - begin] != 0)
+							combine(Row(i) + w0 + b, index[i - begin], b, 
+								count);
+				}
+			};
+			if (pool && tasks > 1)
+				pool->Run(tasks, apply);
+			else
+				for (size_t task = 0; task < tasks; ++task)
+					apply(0, task);
+			r += found;
+		}
+		return r;
+	}
+
+public:
+	//! Число строк
+	size_t Rows() const
+	{
+		return _rows;
+	}
+
+	//! Число столбцов
+	size_t Cols() const
+	{
+		return _cols;
+	}
+
+	//! Число слов в строке
+	size_t Stride() const
+	{
+		return _stride;
+	}
+
+	//! Строка
+	/*! Определяется адрес первого слова строки i. */
+	word* Row(size_t i)
+	{
+		assert(i < _rows);
+		return _data.data() + i * _stride;
+	}
+	const word* Row(size_t i) const
+	{
+		assert(i < _rows);
+		return _data.data() + i * _stride;
+	}
+
+	//! Элемент
+	bool Get(size_t i, size_t j) const
+	{
+		assert(j < _cols);
+		return _Test(Row(i), j);
+	}
+
+	//! Установка элемента
+	void Set(size_t i, size_t j, bool val)
+	{
+		assert(j < _cols);
+		if (val)
+			Row(i)[j / B_PER_W] |= WORD_1 << j % B_PER_W;
+		else
+			Row(i)[j / B_PER_W] &= ~(WORD_1 << j % B_PER_W);
+	}
+
+	//! Инверсия элемента
+	void Flip(size_t i, size_t j)
+	{
+		assert(j < _cols);
+		Row(i)[j / B_PER_W] ^= WORD_1 << j % B_PER_W;
+	}
+
+	//! Установка строки
+	/*! Строка i устанавливается равной слову w.
+		\pre _m <= Cols(). */
+	template<size_t _m>
+	void SetRow(size_t i, const WW<_m>& w)
+	{
+		assert(_m <= _cols);
+		word* row = Row(i);
+		std::fill(row, row + _stride, 0);
+		for (size_t pos = 0; pos < w.WordSize(); ++pos)
+			row[pos] = w.GetWord(pos);
+	}
+
+	//! Получение строки
+	/*! Слово w устанавливается равным строке i.
+		\pre Cols() <= _m. */
+	template<size_t _m>
+	void GetRow(size_t i, WW<_m>& w) const
+	{
+		assert(_cols <= _m);
+		w.SetAllZero();
+		for (size_t pos = 0; pos < _stride; ++pos)
+			w.SetWord(pos, Row(i)[pos]);
+	}
+
+	//! Сложение строк
+	/*! К строке i прибавляется строка j. */
+	void AddRow(size_t i, size_t j)
+	{
+		_Xor(Row(i), Row(j), _stride);
+	}
+
+	//! Перестановка строк
+	void SwapRows(size_t i, size_t j)
+	{
+		if (i != j)
+			std::swap_ranges(Row(i), Row(i) + _stride, Row(j));
+	}
+
+	//! Опорный столбец
+	/*! Определяется номер первого ненулевого элемента строки i.
+		\return Номер столбца или SIZE_MAX для нулевой строки. */
+	size_t Lead(size_t i) const
+	{
+		const word* row = Row(i);
+		for (size_t pos = 0; pos < _stride; ++pos)
+			if (row[pos])
+				return pos * B_PER_W + WordLoBit(row[pos]);
+		return SIZE_MAX;
+	}
+
+	//! Обнуление
+	void SetZero()
+	{
+		std::fill(_data.begin(), _data.end(), 0);
+	}
+
+	//! Задать наудачу
+	void Rand()
+	{
+		if (_data.empty())
+			return;
+		Env::RandMem(_data.data(), _data.size() * sizeof(word));
+		if (_cols % B_PER_W)
+			for (size_t i = 0; i < _rows; ++i)
+				Row(i)[_stride - 1] &= WORD_MAX >> (B_PER_W - _cols % B_PER_W);
+	}
+
+	//! Изменение размеров
+	/*! Матрица заменяется на нулевую матрицу размера rows x cols. */
+	void Resize(size_t rows, size_t cols)
+	{
+		_rows = rows, _cols = cols;
+		_stride = (cols + B_PER_W - 1) / B_PER_W;
+		_data.assign(_rows * _stride, 0);
+	}
+
+	//! Приведение к ступенчатому виду
+	/*! Матрица приводится к ступенчатому виду: первые ненулевые элементы
+		(опорные столбцы) строк 0, 1,..., rank - 1 стоят в возрастающих
+		столбцах, остальные строки нулевые. При reduced == true опорные
+		столбцы в остальных строках обнуляются (приведенный ступенчатый
+		вид, он определяется однозначно).
+		\return Ранг матрицы rank. */
+	size_t Echelon(bool reduced = true)
+	{
+		return _Echelon(0, reduced);
+	}
+
+	//! Приведение к ступенчатому виду (параллельно)
+	/*! Группы строк приводятся на исполнителях пула pool. Результат
+		совпадает с результатом Echelon(reduced). */
+	size_t Echelon(Pool& pool, bool reduced = true)
+	{
+		return _Echelon(&pool, reduced);
+	}
+
+	//! Ранг
+	size_t Rank() const
+	{
+		Mat a(*this);
+		return a.Echelon(false);
+	}
+
+	//! Ядро
+	/*! Определяется базис пространства решений системы Ax = 0, где
+		A -- матрица *this. Векторы базиса возвращаются как строки матрицы
+		ker размера (Cols() - rank) x Cols().
+		\return Размерность ядра. */
+	size_t Kernel(Mat& ker) const
+	{
+		Mat a(*this);
+		size_t rank = a.Echelon();
+		// опорные и свободные столбцы
+		std::vector<size_t> leads(rank), index(_cols, SIZE_MAX);
+		std::vector<bool> isLead(_cols, false);
+		for (size_t i = 0; i < rank; ++i)
+			leads[i] = a.Lead(i), isLead[leads[i]] = true;
+		ker.Resize(_cols - rank, _cols);
+		for (size_t j = 0, t = 0; j < _cols; ++j)
+			if (!isLead[j])
+				index[j] = t, ker.Set(t++, j, 1);
+		// x_{leads[i]} = a[i][j] для свободной x_j = 1
+		for (size_t i = 0; i < rank; ++i)
+		{
+			const word* row = a.Row(i);
+			for (size_t pos = 0; pos < _stride; ++pos)
+				for (word w = row[pos]; w; w &= w - 1)
+				{
+					size_t j = pos * B_PER_W + WordLoBit(w);
+					if (index[j] != SIZE_MAX)
+						ker.Set(index[j], leads[i], 1);
+				}
+		}
+		return ker.Rows();
+	}
+
+	//! Решение системы
+	/*! Находится решение x системы Ax = b, где A -- матрица *this.
+		Символы b и x упакованы в слова так же, как строки матрицы:
+		b содержит ceil(Rows() / B_PER_W) слов, x -- Stride() слов.
+		\return Признак совместности системы. */
+	bool Solve(const std::vector<word>& b, std::vector<word>& x) const
+	{
+		assert(b.size() * B_PER_W >= _rows);
+		// расширенная матрица
+		Mat a(_rows, _cols + 1);
+		for (size_t i = 0; i < _rows; ++i)
+		{
+			std::copy(Row(i), Row(i) + _stride, a.Row(i));
+			a.Set(i, _cols, (b[i / B_PER_W] >> i % B_PER_W & 1) != 0);
+		}
+		size_t rank = a.Echelon();
+		x.assign(_stride, 0);
+		for (size_t i = 0; i < rank; ++i)
+		{
+			size_t j = a.Lead(i);
+			if (j == _cols)
+				return false;
+			if (a.Get(i, _cols))
+				x[j / B_PER_W] |= WORD_1 << j % B_PER_W;
+		}
+		return true;
+	}
+
+	//! Умножение на вектор
+	/*! Определяется y = Ax, где A -- матрица *this. Символы x и y
+		упакованы как в Solve(). */
+	void Mult(const std::vector<word>& x, std::vector<word>& y) const
+	{
+		assert(x.size() >= _stride);
+		y.assign((_rows + B_PER_W - 1) / B_PER_W, 0);
+		for (size_t i = 0; i < _rows; ++i)
+		{
+			word w = 0;
+			for (size_t pos = 0; pos < _stride; ++pos)
+				w ^= Row(i)[pos] & x[pos];
+			for (size_t shift = B_PER_W / 2; shift; shift /= 2)
+				w ^= w >> shift;
+			y[i / B_PER_W] |= (w & 1) << i % B_PER_W;
+		}
+	}
+
+	//! Сравнение
+	bool operator==(const Mat& aRight) const
+	{
+		return _rows == aRight._rows && _cols == aRight._cols &&
+			_data == aRight._data;
+	}
+
+	bool operator!=(const Mat& aRight) const
+	{
+		return !operator==(aRight);
+	}
+
+// конструкторы
+public:
+	//! Конструктор
+	/*! Создается нулевая матрица размера rows x cols. */
+	Mat(size_t rows = 0, size_t cols = 0)
+	{
+		Resize(rows, cols);
+	}
+};
+
+} // namespace GF2
+
+#endif // __GF2_MAT
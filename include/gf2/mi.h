@@ -4,7 +4,7 @@
 \brief Ideals in GF(2)[x0,x1,...]
 \project GF2 [algebra over GF(2)]
 \created 2004.01.01
-\version 2024.05.10
+\version 2026.10.17
 \license This program is released under the MIT License. See Copyright Notices 
 in GF2/info.h.
 *******************************************************************************
@@ -26,9 +26,15 @@ in GF2/info.h.
 
 #include "gf2/defs.h"
 #include "gf2/mp.h"
+#include "gf2/pool.h"
 #include "gf2/zz.h"
 #include <list>
 #include <iostream>
+#include <map>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace GF2 {
 
@@ -851,16 +857,47 @@ public:
 		*/
 	bool Reduce(iterator pos)
 	{	
-		typename MP<_n, _O>::template Geobucket<2> gb(*pos);
-		// будем сохранять в *pos остаток
-		pos->SetEmpty();
+		return _Reduce(pos, *pos, 0);
+	}
+
+	//! Минимизация многочлена системы
+	/*! Многочлен системы в позиции pos минимизируется.
+		При вычислениях используется структура geobucket.
+		\return Признак того, что нормальная форма отличается от исходного 
+ 		многочлена. 
+		\remark Многочлен в позиции pos может быть изменен.
+		Для возврата к нормализованной системе следует выполнить:
+		\code
+			if (*pos == 0) RemoveAt(pos);
+			else Move(pos);
+		\endcode
+		*/
+	bool Minimize(iterator pos) const
+	{	
+		return _Minimize(pos, *pos, 0);
+	}
+
+protected:
+	//! Приведение многочлена системы
+	/*! Многочлен polyRight приводится по многочленам системы, кроме
+		многочлена в позиции pos (polyRight может совпадать с *pos).
+		Если trace != 0, то в trace добавляются мономы, делители которых
+		искались среди старших мономов системы.
+		\return Признак того, что многочлен polyRight изменился. */
+	bool _Reduce(const_iterator pos, MP<_n, _O>& polyRight, 
+		std::vector<MM<_n>>* trace) const
+	{	
+		typename MP<_n, _O>::template Geobucket<2> gb(polyRight);
+		// будем сохранять в polyRight остаток
+		polyRight.SetEmpty();
 		// цикл деления
 		bool changed = false;
 		MM<_n> lm;
 		MP<_n, _O> poly(_order);
 		while (gb.PopLM(lm))
 		{
-			iterator iterPoly = begin();
+			if (trace) trace->push_back(lm);
+			const_iterator iterPoly = begin();
 			for (; iterPoly != end(); ++iterPoly)
 			{
 				// пропускаем многочлен в позиции pos
@@ -879,28 +916,23 @@ public:
 					break;
 				}
 			}
-			if (iterPoly == end()) pos->push_back(lm);
+			if (iterPoly == end()) polyRight.push_back(lm);
 		}
 		return changed;
 	}
 
 	//! Минимизация многочлена системы
-	/*! Многочлен системы в позиции pos минимизируется.
-		При вычислениях используется структура geobucket.
-		\return Признак того, что нормальная форма отличается от исходного 
- 		многочлена. 
-		\remark Многочлен в позиции pos может быть изменен.
-		Для возврата к нормализованной системе следует выполнить:
-		\code
-			if (*pos == 0) RemoveAt(pos);
-			else Move(pos);
-		\endcode
-		*/
-	bool Minimize(iterator pos) const
+	/*! Многочлен polyRight минимизируется по многочленам системы, кроме
+		многочлена в позиции pos (polyRight может совпадать с *pos).
+		Если trace != 0, то в trace добавляются мономы, делители которых
+		искались среди старших мономов системы.
+		\return Признак того, что многочлен polyRight изменился. */
+	bool _Minimize(const_iterator pos, MP<_n, _O>& polyRight, 
+		std::vector<MM<_n>>* trace) const
 	{	
-		typename MP<_n, _O>::template Geobucket<2> gb(*pos);
-		// будем сохранять в *pos остаток
-		pos->SetEmpty();
+		typename MP<_n, _O>::template Geobucket<2> gb(polyRight);
+		// будем сохранять в polyRight остаток
+		polyRight.SetEmpty();
 		// цикл деления
 		bool changed = false;
 		MM<_n> lm;
@@ -908,6 +940,7 @@ public:
 		const_iterator iterPoly = begin();
 		while (iterPoly != end() && gb.PopLM(lm))
 		{
+			if (trace) trace->push_back(lm);
 			// двигаемся от младших многочленов системы к старшим
 			for (; iterPoly != end(); ++iterPoly)
 			{
@@ -936,10 +969,12 @@ public:
 			// возвращаем lm в geobucket и заканчиваем
 			if (iterPoly == end()) gb.SymDiff(lm);
 		}
-		gb.Mount(*pos);
+		gb.Mount(polyRight);
 		return changed;
 	}
 
+public:
+
 	//! Самоприведение
 	/*! Многочлены системы заменяются на нормальные формы.
 		Нулевые формы исключаются из системы, а упрощение прекращается, 
@@ -1006,6 +1041,133 @@ public:
 		return *this;
 	}
 
+	//! Самоприведение
+	/*! Параллельная версия SelfReduce(), которая выполняется 
+		на исполнителях пула pool. Результат совпадает с результатом
+		SelfReduce(). */
+	MI& SelfReduce(Pool& pool)
+	{
+		return _SelfSimplify(pool, false);
+	}
+
+	//! Самоминимизация
+	/*! Параллельная версия SelfMinimize(), которая выполняется 
+		на исполнителях пула pool. Результат совпадает с результатом
+		SelfMinimize(). */
+	MI& SelfMinimize(Pool& pool)
+	{
+		return _SelfSimplify(pool, true);
+	}
+
+protected:
+	//! Параллельное самоупрощение
+	/*! Выполняются проходы SelfReduce() (minimize == false) или 
+		SelfMinimize() (minimize == true). Проход разбивается на окна --
+		группы многочленов, которые будут упрощаться следующими. Многочлены 
+		окна упрощаются по снимку системы параллельно. Затем проход 
+		продолжается последовательно, но вместо упрощения многочлена окна
+		берется результат, полученный по снимку, если этот результат 
+		не мог измениться: старые и новые старшие мономы многочленов, 
+		измененных после снимка, не делят мономы, делители которых 
+		искались при упрощении по снимку. Иначе многочлен упрощается 
+		заново. Поэтому результат совпадает с последовательным. */
+	MI& _SelfSimplify(Pool& pool, bool minimize)
+	{	
+		// важно, чтобы система была нормализована
+		assert(IsNormalized());
+		// нет параллелизма?
+		if (pool.Size() == 1)
+			return minimize ? SelfMinimize() : SelfReduce();
+		// результат упрощения по снимку
+		struct Draft
+		{
+			MP<_n, _O> poly; //< результат
+			std::vector<MM<_n>> trace; //< мономы, делители которых искались
+			bool changed; //< многочлен изменился
+			bool used; //< результат уже просмотрен
+		};
+		const size_t width = 4 * pool.Size();
+		std::vector<const_iterator> window;
+		std::vector<Draft> drafts(width, 
+			Draft{MP<_n, _O>(_order), {}, false, false});
+		std::unordered_map<const MP<_n, _O>*, size_t> index;
+		MMIndex<_n> lms;
+		size_t count = 0;
+		std::vector<word> mask;
+		// цикл проходов
+		bool changed;
+		do
+		{
+			changed = false;
+			index.clear();
+			// двигаемся от старших многочленов к младшим
+			for (iterator pos = end(); pos != begin();)
+			{
+				--pos;
+				// нет результата по снимку? упростить окно
+				auto iter = index.find(&*pos);
+				if (iter == index.end() || drafts[iter->second].used)
+				{
+					window.clear(), index.clear();
+					const_iterator w = pos;
+					index[&*w] = 0, window.push_back(w);
+					while (window.size() < width && w != begin())
+						--w, index[&*w] = window.size(), window.push_back(w);
+					pool.Run(window.size(), [&](size_t, size_t i)
+					{
+						Draft& d = drafts[i];
+						d.poly = *window[i], d.trace.clear(), d.used = false;
+						d.changed = minimize ? 
+							_Minimize(window[i], d.poly, &d.trace) :
+							_Reduce(window[i], d.poly, &d.trace);
+					});
+					lms.Clear(), count = 0;
+					iter = index.find(&*pos);
+				}
+				// результат по снимку годится?
+				Draft* d = &drafts[iter->second];
+				d->used = true;
+				for (auto m = d->trace.begin(); count && 
+					m != d->trace.end(); ++m)
+				{
+					lms.Divisors(*m, mask);
+					if (MMIndex<_n>::Next(mask, 0) != SIZE_MAX)
+					{
+						d = 0;
+						break;
+					}
+				}
+				// упрощение
+				MM<_n> lm = pos->LM();
+				bool ch;
+				if (d)
+				{
+					if ((ch = d->changed))
+						pos->Swap(d->poly);
+				}
+				else
+					ch = minimize ? Minimize(pos) : Reduce(pos);
+				// есть изменения?
+				if (!ch)
+					continue;
+				changed = true;
+				Env::Trace("%s: %zu polys (%zu mons)", 
+					minimize ? "SelfMinimize" : "SelfReduce", 
+					Size(), pos->Size());
+				lms.Insert(count++, lm);
+				// нулевая форма? исключаем
+				if (*pos == 0)
+					pos = RemoveAt(pos);
+				// ненулевая? перемещаем
+				else
+					lms.Insert(count++, pos->LM()), Move(pos++);
+			}
+		}
+		while (changed);
+		return *this;
+	}
+
+public:
 	//! Замена переменной
 	/*! Для всех многочленов системы выполняется замена вхождений переменной 
 		с номером pos на многочлен polyReplace. */
@@ -1017,6 +1179,42 @@ public:
 		Normalize();
 	}
 
+	//! Одновременная замена переменных
+	/*! Для всех многочленов системы выполняется одновременная замена 
+		вхождений переменных с номерами v на многочлены subst[v]
+		(см. MP::Substitute()). Произведения заменяющих многочленов 
+		общие для всех многочленов системы. */
+	template<class _O1>
+	MI& Substitute(const std::map<size_t, MP<_n, _O1>>& subst)
+	{
+		typename MP<_n, _O>::SubstCache cache;
+		for (iterator iter = begin(); iter != end(); ++iter)
+			iter->Substitute(subst, &cache);
+		Normalize();
+		return *this;
+	}
+
+	//! Одновременная замена переменных
+	/*! Параллельная версия Substitute(), которая выполняется 
+		на исполнителях пула pool. Многочлены обрабатываются независимо,
+		у каждого исполнителя свой кэш произведений. */
+	template<class _O1>
+	MI& Substitute(const std::map<size_t, MP<_n, _O1>>& subst, Pool& pool)
+	{
+		if (pool.Size() == 1)
+			return Substitute(subst);
+		std::vector<MP<_n, _O>*> polys;
+		for (iterator iter = begin(); iter != end(); ++iter)
+			polys.push_back(&*iter);
+		std::vector<typename MP<_n, _O>::SubstCache> caches(pool.Size());
+		pool.Run(polys.size(), [&](size_t worker, size_t i)
+		{
+			polys[i]->Substitute(subst, &caches[worker]);
+		});
+		Normalize();
+		return *this;
+	}
+
 	//! Замена переменной
 	/*! Для всех многочленов системы выполняется замена вхождений переменной 
 		с номером pos на переменную с номером posNew. */
@@ -1082,6 +1280,190 @@ public:
 		return true;
 	}
 
+	//! Пара многочленов
+	/*! Пара многочленов системы с номерами pos1 и pos2 (многочлены 
+		нумеруются от 0 в порядке возрастания) или, при pos2 == SIZE_MAX, 
+		пара из многочлена pos1 и уравнения поля x_var^2 + x_var. */
+	struct Pair
+	{
+		size_t pos1; //< номер первого многочлена
+		size_t pos2; //< номер второго многочлена
+		size_t var; //< номер переменной уравнения поля
+	};
+
+	//! Базис Гребнера?
+	/*! Проверяется, что система многочленов является базисом Гребнера 
+		порождаемого идеала. S-многочлены приводятся параллельно 
+		на исполнителях пула pool. Пары многочленов исключаются критериями 
+		Бухбергера: 
+		-	старшие мономы взаимно просты (критерий произведения);
+		-	существует многочлен, старший моном которого делит НОК старших 
+			мономов пары, причем НОК этого монома со старшими мономами 
+			пары -- собственные делители НОК пары (критерий цепочки).
+			Для пары из многочлена и уравнения поля это означает, что 
+			старший моном многочлена делится на другой старший моном.
+		
+		Проверка прекращается на первом S-многочлене с ненулевой 
+		нормальной формой. Соответствующая пара возвращается по адресу 
+		failed (если failed != 0).
+		\remark Если ненулевых нормальных форм несколько, то возвращаемая
+		пара зависит от распределения пар между исполнителями. */
+	bool IsGB(Pool& pool, Pair* failed = 0) const
+	{
+		// многочлены и их старшие мономы
+		std::vector<const_iterator> polys;
+		MMIndex<_n> lms;
+		for (const_iterator iter = begin(); iter != end(); ++iter)
+			lms.Insert(polys.size(), iter->LM()), polys.push_back(iter);
+		// результат
+		std::atomic<bool> ok(true);
+		std::atomic<size_t> trace(0);
+		std::mutex lock;
+		Pair pair{SIZE_MAX, SIZE_MAX, SIZE_MAX};
+		// цикл по многочленам
+		pool.Run(polys.size(), [&](size_t, size_t pos)
+		{
+			MP<_n, _O> poly(_order);
+			std::vector<word> mask;
+			const MM<_n>& lm = polys[pos]->LM();
+			// ненулевая нормальная форма
+			auto fail = [&](size_t pos1, size_t var)
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				if (ok)
+					ok = false, pair = Pair{pos, pos1, var};
+			};
+			// критерий цепочки для пар с уравнениями поля: 
+			// lm делится на другой старший моном
+			bool chain = false;
+			lms.Divisors(lm, mask);
+			for (size_t pos1 = MMIndex<_n>::Next(mask, 0); 
+				!chain && pos1 != SIZE_MAX; 
+				pos1 = MMIndex<_n>::Next(mask, pos1 + 1))
+				chain = polys[pos1]->LM() != lm;
+			// цикл по парам (многочлен, уравнение поля)
+			for (size_t i = 0; ok && !chain && i < _n; i++)
+				if (lm.Test(i))
+				{
+					Reduce(poly.SPoly(i, *polys[pos]));
+					if (poly != 0)
+					{
+						fail(SIZE_MAX, i);
+						return;
+					}
+				}
+			// цикл по парам (многочлен, многочлен1)
+			for (size_t pos1 = 0; ok && pos1 < pos; ++pos1)
+			{
+				const MM<_n>& lm1 = polys[pos1]->LM();
+				// критерий произведения
+				if (lm.IsRelPrime(lm1))
+					continue;
+				// критерий цепочки
+				MM<_n> lcm = LCM(lm, lm1);
+				lms.Divisors(lcm, mask);
+				size_t pos2 = MMIndex<_n>::Next(mask, 0);
+				for (; pos2 != SIZE_MAX; 
+					pos2 = MMIndex<_n>::Next(mask, pos2 + 1))
+				{
+					const MM<_n>& lm2 = polys[pos2]->LM();
+					if (pos2 != pos && pos2 != pos1 && 
+						LCM(lm, lm2) != lcm && LCM(lm1, lm2) != lcm)
+						break;
+				}
+				if (pos2 != SIZE_MAX)
+					continue;
+				// приведение
+				Reduce(poly.SPoly(*polys[pos], *polys[pos1]));
+				if (poly != 0)
+				{
+					fail(pos1, SIZE_MAX);
+					return;
+				}
+			}
+			// трассировка
+			Env::Trace("IsGB: %zu polys", ++trace);
+		});
+		if (!ok && failed)
+			*failed = pair;
+		return ok;
+	}
+
+	//! Перечисление базиса факторкольца
+	/*! Перечисляются элементы базиса факторкольца R/I (см. QuotientBasis()).
+		Для каждого элемента mon вызывается функция f(mon). Элементы
+		не сохраняются, поэтому перечисление возможно и тогда, когда базис 
+		не помещается в память. Порядок вызовов f не определен.
+		\remark Базис замкнут относительно делителей: если моном mon входит 
+		в базис, то в базис входит и mon без старшей переменной. Поэтому 
+		элементы перечисляются обходом дерева, в котором потомки mon 
+		получаются домножением mon на переменные, старшие всех переменных 
+		mon. Каждый элемент встречается в дереве ровно один раз, и проверять
+		повторы не нужно. Делимость на минимальные старшие мономы 
+		проверяется с помощью индекса MMIndex.
+		\pre система должна быть базисом Гребнера.
+		\return размерность базиса. */
+	template<class _F>
+	size_t EnumQuotientBasis(_F&& f) const
+	{
+		if (IsEmpty()) return 0;
+		// существенные переменные
+		std::vector<size_t> vars;
+		MM<_n> mon = GatherVars();
+		for (size_t pos = 0; pos < _n; ++pos)
+			if (mon.Test(pos)) 
+				vars.push_back(pos);
+		// если базис состоит из константы 1
+		if (vars.empty()) return 0;
+		// индекс минимальных старших мономов
+		MP<_n, _O> mons(_order);
+		GatherMinLMons(mons);
+		MMIndex<_n> index;
+		size_t count = 0;
+		for (auto iter = mons.begin(); iter != mons.end(); ++iter)
+			index.Insert(count++, *iter);
+		// начинаем с монома-константы
+		std::vector<word> mask;
+		mon.SetAll(0);
+		index.Divisors(mon, mask);
+		if (index.Next(mask, 0) != SIZE_MAX) return 0;
+		f(mon);
+		count = 1;
+		// стек: номера переменных vars, которые следует попробовать 
+		// для очередного элемента (переменная, добавленная на уровне 
+		// top, -- vars[stack[top] - 1])
+		std::vector<size_t> stack(1, 0);
+		while (!stack.empty())
+		{
+			size_t& next = stack.back();
+			// потомки исчерпаны?
+			if (next == vars.size())
+			{
+				stack.pop_back();
+				if (!stack.empty())
+					mon.Set(vars[stack.back() - 1], 0);
+				continue;
+			}
+			// домножаем на очередную переменную
+			mon.Set(vars[next++], 1);
+			index.Divisors(mon, mask);
+			// один из старших мономов делит mon?
+			if (index.Next(mask, 0) != SIZE_MAX)
+			{
+				mon.Set(vars[next - 1], 0);
+				continue;
+			}
+			// элемент базиса
+			f(mon);
+			stack.push_back(next);
+			// отладочная печать
+			if ((++count & 0xFFFF) == 0)
+				Env::Trace("EnumQuotientBasis: %zu elems", count);
+		}
+		Env::Trace("");
+		return count;
+	}
+
 	//! Базис факторкольца
 	/*! Определяется базис факторкольца R/I как векторного пространства 
 		над двоичным полем. Элементами базиса являются все мономы, которые 
@@ -1089,57 +1471,18 @@ public:
 		\remark Размерность факторкольца совпадает 
 		с числом решений соответствующей I системы уравнений
 		относительно существенных булевых переменных.
+		\remark Если базис нужен только для перебора элементов, то лучше
+		использовать EnumQuotientBasis(), который не хранит базис.
 		\pre система должна быть базисом Гребнера, 
 		размерность факторкольца должна помещаться в size_t. 
 		\return размерность и базис (по ссылке polyQB). */
 	template<class _O1>
 	size_t QuotientBasis(MP<_n, _O1>& polyQB) const
 	{
-		// начинаем с пустого базиса
 		polyQB.SetEmpty();
-		if (IsEmpty()) return 0;
-		// существенные переменные
-		MM<_n> vars = GatherVars();
-		// если базис состоит из константы 1
-		if (vars.Deg() == 0) return 0;
-		// старшие мономы
-		MP<_n, _O> mons(_order);
-		GatherMinLMons(mons);
-		// мономы для просмотра, начинаем с монома-константы
-		MP<_n, _O1> tosee(polyQB.GetOrder());
-		tosee = 1; 
-		// пока есть что просматривать
-		while (!tosee.IsEmpty())
-		{
-			// выбираем и удаляем из списка просмотра младший моном
-			MM<_n> mon = *(--tosee.end());
-			tosee.pop_back();
-			// один из старших мономов делит mon?
-			auto iter = mons.rbegin();
-			for (; iter != mons.rend(); ++iter)
-				if (*iter | mon)
-					break;
-			// элемент базиса и еще не добавлен в базис?
-			if (iter == mons.rend() && !polyQB.IsContain(mon))
-			{
-				// добавить в базис
-				polyQB.Union(mon);
-				// умножаем его на всевозможные существенные переменные
-				for (size_t prev = SIZE_MAX, cur = 0; cur < _n; ++cur)
-					if (vars.Test(cur) && !mon.Test(cur))
-					{
-						mon.Set(cur, 1);
-						if (prev != SIZE_MAX) 
-							mon.Set(prev, 0);
-						prev = cur;
-						tosee.Union(mon);
-					}
-			}
-			// отладочная печать
-			if ((tosee.size() % 23) == 0)
-				Env::Trace("QuotientBasis: %zu elems (%zu tosee)", 
-					polyQB.size(), tosee.size());
-		}
+		EnumQuotientBasis([&](const MM<_n>& mon) { polyQB.push_back(mon); });
+		// упорядочиваем мономы (повторов нет)
+		polyQB.Normalize();
 		return polyQB.Size();
 	}
 
@@ -1223,6 +1566,215 @@ public:
 		return dim;
 	}
 
+	//! Размерность базиса факторкольца (параллельно)
+	/*! Определяется размерность базиса факторкольца R/I (см. 
+		QuotientBasisDim()) с помощью исполнителей пула pool.
+		\remark Число решений системы {m = 0: m in mons} находится 
+		рекурсивно: выбирается переменная x, которая входит в наибольшее 
+		число мономов mons, и решения делятся на решения с x = 0 и x = 1. 
+		Мономы подзадач минимизируются, повторяющиеся подзадачи решаются 
+		один раз (результаты запоминаются). Верхние уровни рекурсии 
+		раскрываются последовательно, пока не наберется достаточно 
+		подзадач, которые затем решаются параллельно.
+		\pre Система должна быть базисом Гребнера. */
+	ZZ<_n> QuotientBasisDim(Pool& pool) const
+	{
+		ZZ<_n> dim = 0;
+		// пустая система?
+		if (IsEmpty()) return dim;
+		// подзадачи: мономы и число свободных переменных
+		std::vector<std::pair<_Mons, size_t>> tasks(1), next;
+		MP<_n, _O> mons(_order);
+		GatherMinLMons(mons);
+		tasks[0].first.assign(mons.begin(), mons.end());
+		tasks[0].second = GatherVars().Weight() - 
+			_Vars(tasks[0].first).Weight();
+		// раскрываем верхние уровни рекурсии
+		while (tasks.size() < 4 * pool.Size())
+		{
+			next.clear();
+			for (auto iter = tasks.begin(); iter != tasks.end(); ++iter)
+			{
+				_Mons& mons0 = iter->first;
+				if (mons0.size() <= 1)
+				{
+					next.push_back(*iter);
+					continue;
+				}
+				size_t weight = _Vars(mons0).Weight() - 1;
+				next.resize(next.size() + 2);
+				_Mons& mons1 = next.back().first;
+				_Split(mons0, mons1);
+				next.back().second = iter->second + weight - 
+					_Vars(mons1).Weight();
+				next[next.size() - 2].second = iter->second + weight - 
+					_Vars(mons0).Weight();
+				next[next.size() - 2].first.swap(mons0);
+			}
+			if (next.size() == tasks.size())
+				break;
+			tasks.swap(next);
+		}
+		// решаем подзадачи
+		std::vector<_Memo> memos(pool.Size());
+		std::vector<ZZ<_n>> dims(tasks.size());
+		pool.Run(tasks.size(), [&](size_t worker, size_t task)
+		{
+			dims[task] = _Count(tasks[task].first, memos[worker]).
+				ShHi(tasks[task].second);
+		});
+		for (size_t task = 0; task < tasks.size(); ++task)
+			dim += dims[task];
+		return dim;
+	}
+
+protected:
+	typedef std::vector<MM<_n>> _Mons;
+
+	//! Хэширование наборов мономов
+	struct _MonsHash
+	{
+		size_t operator()(const std::vector<word>& key) const
+		{
+			size_t h = key.size();
+			for (auto iter = key.begin(); iter != key.end(); ++iter)
+				h = (h ^ size_t(*iter)) * size_t(0x9E3779B97F4A7C15ull) + 
+					(h >> 29);
+			return h;
+		}
+	};
+
+	//! Запомненные числа решений подзадач
+	typedef std::unordered_map<std::vector<word>, ZZ<_n>, _MonsHash> _Memo;
+
+	//! Переменные мономов
+	static MM<_n> _Vars(const _Mons& mons)
+	{
+		MM<_n> vars;
+		for (auto iter = mons.begin(); iter != mons.end(); ++iter)
+			vars *= *iter;
+		return vars;
+	}
+
+	//! Минимизация набора мономов
+	/*! Из mons удаляются мономы, которые делятся на другие мономы. */
+	static void _MinimizeMons(_Mons& mons)
+	{
+		std::sort(mons.begin(), mons.end(), 
+			[](const MM<_n>& m1, const MM<_n>& m2)
+			{
+				return m1.Weight() < m2.Weight();
+			});
+		size_t count = 0;
+		for (size_t i = 0; i < mons.size(); ++i)
+		{
+			size_t j = 0;
+			while (j < count && !(mons[j] | mons[i]))
+				++j;
+			if (j == count)
+				mons[count++] = mons[i];
+		}
+		mons.resize(count);
+	}
+
+	//! Ведущая переменная
+	/*! Определяется переменная, которая входит в наибольшее число 
+		мономов mons. 
+		\return номер переменной или SIZE_MAX, если мономы mons попарно 
+		не имеют общих переменных. */
+	static size_t _Pivot(const _Mons& mons)
+	{
+		size_t freq[_n] = {0}, var = SIZE_MAX, max = 1;
+		for (auto iter = mons.begin(); iter != mons.end(); ++iter)
+			for (size_t i = 0; i < iter->WordSize(); ++i)
+				for (word w = iter->GetWord(i); w; w &= w - 1)
+				{
+					size_t pos = i * B_PER_W + WordLoBit(w);
+					if (++freq[pos] > max)
+						max = freq[pos], var = pos;
+				}
+		return var;
+	}
+
+	//! Расщепление
+	/*! Минимальный набор мономов mons расщепляется по ведущей переменной x
+		(первой переменной монома mons[0], если ведущей нет): mons 
+		заменяется на минимальный набор для x = 0, mons1 -- для x = 1. */
+	static void _Split(_Mons& mons, _Mons& mons1)
+	{
+		assert(mons.size() > 1);
+		size_t var = _Pivot(mons);
+		if (var == SIZE_MAX)
+			for (var = 0; !mons[0].Test(var); ++var);
+		mons1.clear();
+		size_t count = 0;
+		for (size_t i = 0; i < mons.size(); ++i)
+			if (mons[i].Test(var))
+				mons1.push_back(mons[i]), mons1.back().Set(var, 0);
+			else
+				mons1.push_back(mons[i]), mons[count++] = mons[i];
+		mons.resize(count);
+		_MinimizeMons(mons1);
+	}
+
+	//! Число решений
+	/*! Определяется число решений системы {m = 0: m in mons} относительно
+		переменных мономов mons. Результаты для больших наборов мономов 
+		запоминаются в memo. 
+		\pre Набор mons минимален. Набор mons может изменяться. */
+	static ZZ<_n> _Count(_Mons& mons, _Memo& memo)
+	{
+		// решений нет?
+		if (mons.size() == 1 && mons[0].Weight() == 0)
+			return ZZ<_n>(0);
+		// исключаем уравнения x_i = 0 (x_i не входит в другие мономы)
+		size_t count = 0;
+		for (size_t i = 0; i < mons.size(); ++i)
+			if (mons[i].Weight() > 1)
+				mons[count++] = mons[i];
+		mons.resize(count);
+		// нет уравнений?
+		if (mons.empty())
+			return ZZ<_n>(1);
+		// мономы попарно не имеют общих переменных?
+		if (_Pivot(mons) == SIZE_MAX)
+		{
+			ZZ<_n> dim(1);
+			for (auto iter = mons.begin(); iter != mons.end(); ++iter)
+				dim *= ZZ<_n>(1).ShHi(iter->Weight()) - ZZ<_n>(1);
+			return dim;
+		}
+		// результат запомнен?
+		std::sort(mons.begin(), mons.end(), 
+			[](const MM<_n>& m1, const MM<_n>& m2)
+			{
+				for (size_t i = 0; i < m1.WordSize(); ++i)
+					if (m1.GetWord(i) != m2.GetWord(i))
+						return m1.GetWord(i) < m2.GetWord(i);
+				return false;
+			});
+		std::vector<word> key;
+		for (auto iter = mons.begin(); iter != mons.end(); ++iter)
+			for (size_t i = 0; i < iter->WordSize(); ++i)
+				key.push_back(iter->GetWord(i));
+		auto pos = memo.find(key);
+		if (pos != memo.end())
+			return pos->second;
+		// расщепление
+		size_t weight = _Vars(mons).Weight() - 1;
+		_Mons mons1;
+		_Split(mons, mons1);
+		size_t free0 = weight - _Vars(mons).Weight();
+		size_t free1 = weight - _Vars(mons1).Weight();
+		ZZ<_n> dim = _Count(mons, memo).ShHi(free0) + 
+			_Count(mons1, memo).ShHi(free1);
+		// ограничиваем расход памяти
+		if (memo.size() >= (size_t(1) << 20))
+			memo.clear();
+		memo.emplace(std::move(key), dim);
+		return dim;
+	}
+
 // конструкторы
 public:
 	//! Конструктор по умолчанию
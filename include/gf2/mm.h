@@ -4,7 +4,7 @@
 \brief Monomials in GF(2)[x0,x1,...]
 \project GF2 [algebra over GF(2)]
 \created 2004.01.01
-\version 2020.05.07
+\version 2026.10.16
 \license This program is released under the MIT License. See Copyright Notices 
 in GF2/info.h.
 *******************************************************************************
@@ -16,7 +16,8 @@ in GF2/info.h.
 \brief Мономы от нескольких переменных
 
 Модуль содержит описание и реализацию класса MM, поддерживающего манипуляции 
-с мономами от нескольких переменных
+с мономами от нескольких переменных, и классов MMIndex, MMTree (индексов 
+мономов для поиска делителей и кратных)
 *******************************************************************************
 */
 
@@ -26,7 +27,9 @@ in GF2/info.h.
 #include "gf2/ww.h"
 #include "gf2/zz.h"
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 namespace GF2 {
 
@@ -332,6 +335,415 @@ operator/(const MM<_n>& mLeft, const MM<_m>& mRight)
 	return m;
 }
 
+/*!
+*******************************************************************************
+Класс MMIndex
+
+Индекс множества мономов, поддерживающий быстрый поиск делителей и кратных.
+
+Мономы хранятся в транспонированном виде: для каждой переменной x_i 
+поддерживается битовая строка, pos-й бит которой равняется 1, если моном 
+в позиции pos содержит x_i. Дополнительная строка отмечает занятые позиции. 
+Поиск кратных монома m сводится к логическому умножению строк переменных m, 
+поиск делителей -- к логическому умножению дополнений строк остальных 
+переменных. Каждая операция над машинными словами обрабатывает B_PER_W 
+мономов одновременно.
+
+Запрос просматривает все позиции: поиск кратных m обрабатывает |m| строк, 
+поиск делителей -- _n - |m| строк, по MaskSize() слов каждая. Время 
+запроса растет линейно с числом позиций, поэтому индекс подходит для 
+небольших множеств (например, старших мономов базиса). В больших 
+множествах, где подходящих мономов мало, запросы быстрее выполняет 
+дерево делителей MMTree.
+
+Позиции назначаются пользователем (например, номера пар в очереди), 
+результаты поиска возвращаются в виде масок занятых позиций. Маски 
+обходятся с помощью метода Next():
+\code
+	MMIndex<n> index;
+	std::vector<word> mask;
+	...
+	index.Multiples(m, mask);
+	for (size_t pos = index.Next(mask, 0); pos != SIZE_MAX; 
+		pos = index.Next(mask, pos + 1))
+		...
+\endcode
+*******************************************************************************
+*/
+
+template<size_t _n> class MMIndex
+{
+	std::vector<word> _bits; //< строки переменных и строка занятости
+	size_t _stride; //< число машинных слов в строке
+
+	//! Строка
+	/*! Определяется адрес строки с номером row (row == _n -- строка 
+		занятости). */
+	word* _Row(size_t row)
+	{
+		return _bits.data() + row * _stride;
+	}
+	const word* _Row(size_t row) const
+	{
+		return _bits.data() + row * _stride;
+	}
+
+	//! Расширение
+	/*! Строки расширяются так, чтобы вместить позицию pos. */
+	void _Reserve(size_t pos)
+	{
+		if (pos / B_PER_W < _stride)
+			return;
+		size_t stride = std::max<size_t>(_stride, 1);
+		while (stride <= pos / B_PER_W)
+			stride *= 2;
+		std::vector<word> bits((_n + 1) * stride, 0);
+		for (size_t row = 0; row <= _n; ++row)
+			std::copy(_Row(row), _Row(row) + _stride, 
+				bits.data() + row * stride);
+		_bits.swap(bits), _stride = stride;
+	}
+
+public:
+	//! Очистка
+	/*! Индекс очищается. Выделенная память сохраняется. */
+	void Clear()
+	{
+		std::fill(_bits.begin(), _bits.end(), 0);
+	}
+
+	//! Число машинных слов в маске
+	size_t MaskSize() const
+	{
+		return _stride;
+	}
+
+	//! Занята позиция?
+	bool IsUsed(size_t pos) const
+	{
+		return pos / B_PER_W < _stride && 
+			(_Row(_n)[pos / B_PER_W] >> pos % B_PER_W & 1);
+	}
+
+	//! Вставка
+	/*! В позицию pos вставляется моном m.
+		\pre Позиция pos свободна. */
+	void Insert(size_t pos, const MM<_n>& m)
+	{
+		assert(!IsUsed(pos));
+		_Reserve(pos);
+		word bit = WORD_1 << pos % B_PER_W;
+		pos /= B_PER_W;
+		_Row(_n)[pos] |= bit;
+		for (size_t i = 0; i < m.WordSize(); ++i)
+			for (word w = m.GetWord(i); w; w &= w - 1)
+				_Row(i * B_PER_W + WordLoBit(w))[pos] |= bit;
+	}
+
+	//! Удаление
+	/*! Из позиции pos удаляется моном m.
+		\pre Моном m был вставлен в позицию pos. */
+	void Erase(size_t pos, const MM<_n>& m)
+	{
+		assert(IsUsed(pos));
+		word bit = ~(WORD_1 << pos % B_PER_W);
+		pos /= B_PER_W;
+		_Row(_n)[pos] &= bit;
+		for (size_t i = 0; i < m.WordSize(); ++i)
+			for (word w = m.GetWord(i); w; w &= w - 1)
+				_Row(i * B_PER_W + WordLoBit(w))[pos] &= bit;
+	}
+
+	//! Кратные
+	/*! В mask отмечаются позиции мономов, которые делятся на m. */
+	void Multiples(const MM<_n>& m, std::vector<word>& mask) const
+	{
+		mask.assign(_Row(_n), _Row(_n) + _stride);
+		for (size_t i = 0; i < m.WordSize(); ++i)
+			for (word w = m.GetWord(i); w; w &= w - 1)
+			{
+				const word* row = _Row(i * B_PER_W + WordLoBit(w));
+				for (size_t pos = 0; pos < _stride; ++pos)
+					mask[pos] &= row[pos];
+			}
+	}
+
+	//! Делители
+	/*! В mask отмечаются позиции мономов, которые делят m. */
+	void Divisors(const MM<_n>& m, std::vector<word>& mask) const
+	{
+		mask.assign(_Row(_n), _Row(_n) + _stride);
+		for (size_t i = 0; i < _n; ++i)
+			if (!m.Test(i))
+			{
+				const word* row = _Row(i);
+				for (size_t pos = 0; pos < _stride; ++pos)
+					mask[pos] &= ~row[pos];
+			}
+	}
+
+	//! Следующая позиция
+	/*! Определяется наименьшая позиция, не меньшая pos, которая 
+		отмечена в mask. 
+		\return Найденная позиция или SIZE_MAX, если позиции нет. */
+	static size_t Next(const std::vector<word>& mask, size_t pos)
+	{
+		size_t i = pos / B_PER_W;
+		if (i >= mask.size())
+			return SIZE_MAX;
+		word w = mask[i] & (WORD_MAX << pos % B_PER_W);
+		while (w == 0)
+			if (++i == mask.size())
+				return SIZE_MAX;
+			else
+				w = mask[i];
+		return i * B_PER_W + WordLoBit(w);
+	}
+
+// конструкторы
+public:
+	MMIndex() : _stride(0)
+	{
+	}
+};
+
+/*!
+*******************************************************************************
+Класс MMTree
+
+Дерево делителей: индекс множества мономов, в котором поиск делителей 
+и кратных затрагивает только подходящие мономы.
+
+Моном представляется возрастающей последовательностью номеров своих 
+переменных, и мономы хранятся в префиксном дереве (trie) этих 
+последовательностей. Узел соответствует префиксу, сыновья узла 
+упорядочены по возрастанию номеров переменных. В узле хранится список
+позиций мономов, которые совпадают с префиксом, число позиций 
+в поддереве и произведение мономов поддерева. Узлы с пустыми поддеревьями 
+удаляются. Произведение при удалении мономов не пересчитывается и может 
+содержать лишние переменные.
+
+Поиск делителей m обходит только узлы, префиксы которых делят m (сыновья 
+с переменными, не входящими в m, пропускаются). Поиск кратных m обходит 
+узлы, префиксы которых могут быть продолжены до кратных m: переменные 
+m сопоставляются по возрастанию, и сыновья с переменной больше очередной 
+несопоставленной переменной m или с произведением мономов, которое 
+не делится на m, пропускаются. Если все переменные m сопоставлены, 
+то поддерево добавляется целиком. Время запроса определяется числом 
+подходящих мономов и их префиксов, а не числом позиций, как в MMIndex.
+
+Позиции назначаются пользователем (например, номера пар в очереди), 
+результаты поиска возвращаются как списки позиций по возрастанию:
+\code
+	MMTree<n> tree;
+	std::vector<size_t> found;
+	...
+	tree.Multiples(m, found);
+	for (size_t pos : found)
+		...
+\endcode
+*******************************************************************************
+*/
+
+template<size_t _n> class MMTree
+{
+	//! Узел дерева
+	struct _Node
+	{
+		size_t var; //< номер последней переменной префикса
+		size_t parent; //< отец
+		size_t child; //< первый сын
+		size_t next; //< следующий брат
+		size_t head; //< первая позиция узла
+		size_t count; //< число позиций в поддереве
+		MM<_n> mons; //< произведение мономов поддерева (с учетом удаленных)
+	};
+
+	std::vector<_Node> _nodes; //< узлы (0 -- корень)
+	size_t _free; //< первый свободный узел (связаны через next)
+	std::vector<size_t> _at; //< узлы позиций
+	std::vector<size_t> _link; //< следующие позиции узлов
+	std::vector<size_t> _prev; //< предыдущие позиции узлов
+
+	//! Новый узел
+	size_t _NewNode(size_t var, size_t parent, size_t next)
+	{
+		size_t node = _free;
+		if (node != SIZE_MAX)
+			_free = _nodes[node].next;
+		else
+			node = _nodes.size(), _nodes.emplace_back();
+		_nodes[node] = _Node{var, parent, SIZE_MAX, next, SIZE_MAX, 0, 
+			MM<_n>()};
+		return node;
+	}
+
+	//! Позиции поддерева
+	/*! В found добавляются позиции поддерева с корнем node. */
+	void _Collect(size_t node, std::vector<size_t>& found) const
+	{
+		for (size_t pos = _nodes[node].head; pos != SIZE_MAX; pos = _link[pos])
+			found.push_back(pos);
+		for (size_t c = _nodes[node].child; c != SIZE_MAX; c = _nodes[c].next)
+			_Collect(c, found);
+	}
+
+	//! Кратные в поддереве
+	/*! В found добавляются позиции поддерева с корнем node, мономы 
+		которых делятся на m. Переменные vars[0],..., vars[j - 1] монома m
+		входят в префикс node, переменные vars[j],..., vars[k - 1] -- нет. 
+		Поддеревья, произведение мономов которых не делится на m, 
+		пропускаются. */
+	void _Multiples(size_t node, const MM<_n>& m, const size_t* vars, 
+		size_t j, size_t k, std::vector<size_t>& found) const
+	{
+		if (j == k)
+		{
+			_Collect(node, found);
+			return;
+		}
+		for (size_t c = _nodes[node].child; 
+			c != SIZE_MAX && _nodes[c].var <= vars[j]; c = _nodes[c].next)
+			if (m | _nodes[c].mons)
+				_Multiples(c, m, vars, j + (_nodes[c].var == vars[j]), k, 
+					found);
+	}
+
+	//! Делители в поддереве
+	/*! В found добавляются позиции поддерева с корнем node, мономы
+		которых делят m. */
+	void _Divisors(size_t node, const MM<_n>& m, 
+		std::vector<size_t>& found) const
+	{
+		for (size_t pos = _nodes[node].head; pos != SIZE_MAX; pos = _link[pos])
+			found.push_back(pos);
+		for (size_t c = _nodes[node].child; c != SIZE_MAX; c = _nodes[c].next)
+			if (m.Test(_nodes[c].var))
+				_Divisors(c, m, found);
+	}
+
+public:
+	//! Очистка
+	/*! Дерево очищается. Выделенная память сохраняется. */
+	void Clear()
+	{
+		_nodes.assign(1, _Node{SIZE_MAX, SIZE_MAX, SIZE_MAX, SIZE_MAX, 
+			SIZE_MAX, 0, MM<_n>()});
+		_free = SIZE_MAX;
+		std::fill(_at.begin(), _at.end(), SIZE_MAX);
+	}
+
+	//! Занята позиция?
+	bool IsUsed(size_t pos) const
+	{
+		return pos < _at.size() && _at[pos] != SIZE_MAX;
+	}
+
+	//! Число мономов
+	size_t Size() const
+	{
+		return _nodes[0].count;
+	}
+
+	//! Вставка
+	/*! В позицию pos вставляется моном m.
+		\pre Позиция pos свободна. */
+	void Insert(size_t pos, const MM<_n>& m)
+	{
+		assert(!IsUsed(pos));
+		if (pos >= _at.size())
+			_at.resize(pos + 1, SIZE_MAX), _link.resize(pos + 1), 
+				_prev.resize(pos + 1);
+		// спуск с созданием недостающих узлов
+		size_t node = 0;
+		++_nodes[0].count, _nodes[0].mons *= m;
+		for (size_t i = 0; i < m.WordSize(); ++i)
+			for (word w = m.GetWord(i); w; w &= w - 1)
+			{
+				size_t var = i * B_PER_W + WordLoBit(w);
+				size_t prev = SIZE_MAX, c = _nodes[node].child;
+				while (c != SIZE_MAX && _nodes[c].var < var)
+					prev = c, c = _nodes[c].next;
+				if (c == SIZE_MAX || _nodes[c].var != var)
+				{
+					size_t fresh = _NewNode(var, node, c);
+					(prev == SIZE_MAX ? _nodes[node].child : 
+						_nodes[prev].next) = fresh;
+					c = fresh;
+				}
+				node = c, ++_nodes[node].count, _nodes[node].mons *= m;
+			}
+		size_t& head = _nodes[node].head;
+		if (head != SIZE_MAX)
+			_prev[head] = pos;
+		_link[pos] = head, _prev[pos] = SIZE_MAX;
+		head = pos, _at[pos] = node;
+	}
+
+	//! Удаление
+	/*! Из позиции pos удаляется моном m.
+		\pre Моном m был вставлен в позицию pos. */
+	void Erase(size_t pos, const MM<_n>& m)
+	{
+		assert(IsUsed(pos));
+		size_t node = _at[pos];
+		assert(_nodes[node].count > 0 && (node == 0 ? m.IsAllZero() : 
+			m.Test(_nodes[node].var)));
+		(void)m;
+		// исключение из списка позиций узла
+		(_prev[pos] == SIZE_MAX ? _nodes[node].head : _link[_prev[pos]]) = 
+			_link[pos];
+		if (_link[pos] != SIZE_MAX)
+			_prev[_link[pos]] = _prev[pos];
+		_at[pos] = SIZE_MAX;
+		// подъем с удалением пустых узлов
+		while (--_nodes[node].count == 0 && node != 0)
+		{
+			size_t parent = _nodes[node].parent;
+			size_t* c = &_nodes[parent].child;
+			while (*c != node)
+				c = &_nodes[*c].next;
+			*c = _nodes[node].next;
+			_nodes[node].next = _free, _free = node;
+			node = parent;
+		}
+		if (_nodes[node].count != 0)
+			while ((node = _nodes[node].parent) != SIZE_MAX)
+				--_nodes[node].count;
+	}
+
+	//! Кратные
+	/*! В found по возрастанию записываются позиции мономов, которые 
+		делятся на m. */
+	void Multiples(const MM<_n>& m, std::vector<size_t>& found) const
+	{
+		size_t vars[_n], k = 0;
+		for (size_t i = 0; i < m.WordSize(); ++i)
+			for (word w = m.GetWord(i); w; w &= w - 1)
+				vars[k++] = i * B_PER_W + WordLoBit(w);
+		found.clear();
+		_Multiples(0, m, vars, 0, k, found);
+		std::sort(found.begin(), found.end());
+	}
+
+	//! Делители
+	/*! В found по возрастанию записываются позиции мономов, которые
+		делят m. */
+	void Divisors(const MM<_n>& m, std::vector<size_t>& found) const
+	{
+		found.clear();
+		_Divisors(0, m, found);
+		std::sort(found.begin(), found.end());
+	}
+
+// конструкторы
+public:
+	MMTree()
+	{
+		Clear();
+	}
+};
+
 //! Вывод в поток
 /*! Моном mRight выводится в поток os. */
 template<class _Char, class _Traits, size_t _n> inline 
@@ -4,7 +4,7 @@
 \brief Monomial orders in GF(2)[x0,x1,...]
 \project GF2 [algebra over GF(2)]
 \created 2004.01.01
-\version 2020.04.22
+\version 2026.10.16
 \license This program is released under the MIT License. See Copyright Notices 
 in GF2/info.h.
 *******************************************************************************
@@ -23,6 +23,7 @@ in GF2/info.h.
 #define __GF2_MO
 
 #include "gf2/mm.h"
+#include <cstring>
 #include <functional>
 
 namespace GF2 {
@@ -80,6 +81,10 @@ operator==(), Compare, operator(), operator==() и Next
 a = a0 a1 .... a_{n-1} и b = b0 b1 ... b_{n-1} мономов. 
 Экспоненты считаются векторами с неотрицательными целочисленными 
 координатами. Степенью (deg) монома является сумма координат экспоненты.
+
+Каждый порядок имеет идентификатор id. Идентификаторы составных порядков
+строятся по идентификаторам вложенных. Идентификатор вместе с данными-
+параметрами порядка сохраняется при двоичной сериализации (см. io.h).
 *******************************************************************************
 */
 
@@ -100,6 +105,9 @@ a - b положительна.
 
 template<size_t _n> struct MOLex : public MO<_n>
 {
+	//! идентификатор
+	static constexpr u32 id = 1;
+
 	//! Равенство порядков
 	/*! Проверяется (обязательное!) совпадение с другим порядком lex. */	
 	bool operator==(const MOLex&) const
@@ -147,6 +155,9 @@ template<size_t _n> struct MOLex : public MO<_n>
 
 template<size_t _n> struct MOGrlex : public MO<_n>
 {
+	//! идентификатор
+	static constexpr u32 id = 2;
+
 	//! Равенство порядков
 	/*! Проверяется (обязательное!) совпадение с другим порядком grlex. */	
 	bool operator==(const MOGrlex<_n>&) const
@@ -217,6 +228,28 @@ template<size_t _n> struct MOGrlex : public MO<_n>
 	}
 };
 
+//! Разворот разрядов байта
+/*! RevByte[b] -- байт b, разряды которого записаны в обратном порядке. */
+inline constexpr u8 RevByte[256] =
+{
+	 0,128,64,192,32,160, 96,224,16,144,80,208,48,176,112,240,
+	 8,136,72,200,40,168,104,232,24,152,88,216,56,184,120,248,
+	 4,132,68,196,36,164,100,228,20,148,84,212,52,180,116,244,
+	12,140,76,204,44,172,108,236,28,156,92,220,60,188,124,252,
+	 2,130,66,194,34,162, 98,226,18,146,82,210,50,178,114,242,
+	10,138,74,202,42,170,106,234,26,154,90,218,58,186,122,250,
+	 6,134,70,198,38,166,102,230,22,150,86,214,54,182,118,246,
+	14,142,78,206,46,174,110,238,30,158,94,222,62,190,126,254,
+	 1,129,65,193,33,161, 97,225,17,145,81,209,49,177,113,241,
+	 9,137,73,201,41,169,105,233,25,153,89,217,57,185,121,249,
+	 5,133,69,197,37,165,101,229,21,149,85,213,53,181,117,245,
+	13,141,77,205,45,173,109,237,29,157,93,221,61,189,125,253,
+	 3,131,67,195,35,163, 99,227,19,147,83,211,51,179,115,243,
+	11,139,75,203,43,171,107,235,27,155,91,219,59,187,123,251,
+	 7,135,71,199,39,167,103,231,23,151,87,215,55,183,119,247,
+	15,143,79,207,47,175,111,239,31,159,95,223,63,191,127,255,
+};
+
 /*!
 *******************************************************************************
 Класс MOGrevlex
@@ -229,6 +262,9 @@ a > b, если deg(a) > deg(b) или deg(a) == deg(b) и самая левая
 
 template<size_t _n> struct MOGrevlex : public MO<_n>
 {
+	//! идентификатор
+	static constexpr u32 id = 3;
+
 	//! Равенство порядков
 	/*! Проверяется (обязательное!) совпадение с другим порядком grevlex.*/
 	bool operator==(const MOGrevlex<_n>&) const
@@ -258,28 +294,8 @@ template<size_t _n> struct MOGrevlex : public MO<_n>
 		word w1 = m1.GetWord(pos), w2 = m2.GetWord(pos);
 		// находим самые младшие несовпадающие байты
 		for (; (w1 & 255) == (w2 & 255); w1 >>= 8, w2 >>= 8);
-		// делаем разворот разрядов байта
-		static const u8 _revbyte[256] = 
-		{
-			 0,128,64,192,32,160, 96,224,16,144,80,208,48,176,112,240,
-			 8,136,72,200,40,168,104,232,24,152,88,216,56,184,120,248,
-			 4,132,68,196,36,164,100,228,20,148,84,212,52,180,116,244,
-			12,140,76,204,44,172,108,236,28,156,92,220,60,188,124,252,
-			 2,130,66,194,34,162, 98,226,18,146,82,210,50,178,114,242,
-			10,138,74,202,42,170,106,234,26,154,90,218,58,186,122,250,
-			 6,134,70,198,38,166,102,230,22,150,86,214,54,182,118,246,
-			14,142,78,206,46,174,110,238,30,158,94,222,62,190,126,254,
-			 1,129,65,193,33,161, 97,225,17,145,81,209,49,177,113,241,
-			 9,137,73,201,41,169,105,233,25,153,89,217,57,185,121,249,
-			 5,133,69,197,37,165,101,229,21,149,85,213,53,181,117,245,
-			13,141,77,205,45,173,109,237,29,157,93,221,61,189,125,253,
-			 3,131,67,195,35,163, 99,227,19,147,83,211,51,179,115,243,
-			11,139,75,203,43,171,107,235,27,155,91,219,59,187,123,251,
-			 7,135,71,199,39,167,103,231,23,151,87,215,55,183,119,247,
-			15,143,79,207,47,175,111,239,31,159,95,223,63,191,127,255,
-		};
-		// и сравниваем "байты-как-числа"
-		if (_revbyte[w1 & 255] < _revbyte[w2 & 255])
+		// разворачиваем разряды байтов и сравниваем "байты-как-числа"
+		if (RevByte[w1 & 255] < RevByte[w2 & 255])
 			return 1;
 		return -1;
 	}
@@ -374,6 +390,9 @@ J. Symb. Comp. 2 (1986) 139–170], что любой мономиальный 
 
 template<size_t _n> struct MOAlex : public MO<_n>
 {
+	//! идентификатор
+	static constexpr u32 id = 4;
+
 	//! Матрица A
 	word A[_n][_n];
 
@@ -381,7 +400,7 @@ template<size_t _n> struct MOAlex : public MO<_n>
 	/*! Проверяется совпадение с другим порядком alex. */	
 	bool operator==(const MOAlex<_n>& oRight) const
 	{
-		return std::memcmp(A, oRight._A, sizeof(A)) == 0;
+		return std::memcmp(A, oRight.A, sizeof(A)) == 0;
 	}
 
 	//! Сравнение alex
@@ -423,7 +442,8 @@ template<size_t _n> struct MOAlex : public MO<_n>
 	MOAlex()
 	{
 		std::memset(A, 0, sizeof(A));
-		for (size_t pos = 0; pos < _n; A[pos][pos++] = 1);
+		for (size_t pos = 0; pos < _n; ++pos)
+			A[pos][pos] = 1;
 	}
 
 };
@@ -439,6 +459,9 @@ template<size_t _n> struct MOAlex : public MO<_n>
 
 template<typename _O> struct MORev : public MO<_O::n>
 {
+	//! идентификатор
+	static constexpr u32 id = 5 + 31 * _O::id;
+
 	//! вложенный порядок
 	_O order;
 
@@ -499,6 +522,9 @@ template<typename _O> struct MORev : public MO<_O::n>
 
 template<class _O> struct MOGr : public MO<_O::n>
 {
+	//! идентификатор
+	static constexpr u32 id = 6 + 31 * _O::id;
+
 	//! вложенный порядок
 	_O order;
 
@@ -546,6 +572,9 @@ template<class _O> struct MOGr : public MO<_O::n>
 
 template<class _O1, class _O2> struct MOLR : public MO<_O1::n + _O2::n>
 {
+	//! идентификатор
+	static constexpr u32 id = (7 + 31 * _O1::id) * 31 + _O2::id;
+
 	//! вложенный "левый" порядок
 	_O1 order1;
 	//! вложенный "правый" порядок
@@ -631,6 +660,9 @@ template<class _O1, class _O2> struct MOLR : public MO<_O1::n + _O2::n>
 
 template<class _O1, class _O2> struct MORL : public MO<_O1::n + _O2::n>
 {
+	//! идентификатор
+	static constexpr u32 id = (8 + 31 * _O1::id) * 31 + _O2::id;
+
 	//! вложенный "левый" порядок
 	_O1 order1;
 	//! вложенный "правый" порядок
@@ -4,7 +4,7 @@
 \brief Multivariate polynomials in GF(2)[x0,x1,...]
 \project GF2 [algebra over GF(2)]
 \created 2004.01.01
-\version 2024.05.08
+\version 2026.10.17
 \license This program is released under the MIT License. See Copyright Notices 
 in GF2/info.h.
 *******************************************************************************
@@ -27,6 +27,7 @@ in GF2/info.h.
 #include "gf2/mm.h"
 #include "gf2/mo.h"
 #include <list>
+#include <map>
 #include <vector>
 #include <algorithm>
 #include <functional>
@@ -175,12 +176,98 @@ public:
 	}
 
 // управление списком мономов
-public:
-	//! Нормализация
-	/*! Выполняется сортировка мономов по убыванию и удаление пар одинаковых
-		мономов. */
-	void Normalize()
-	{	
+protected:
+	//! Порог поразрядной сортировки
+	/*! Многочлены с меньшим числом мономов сортируются сравнениями. */
+	static constexpr size_t _radixMin = 64;
+
+	//! Поразрядная сортировка
+	/*! Мономы сортируются по убыванию, повторы удаляются парами. 
+		Используется сортировка LSD по байтам слов-экспонент: 
+		при rev == false байты просматриваются от младших слов 
+		к старшим и мономы упорядочиваются по убыванию байтов (lex),
+		при rev == true байты просматриваются в обратном порядке,
+		их разряды разворачиваются, и мономы упорядочиваются 
+		по возрастанию развернутых байтов (хвост grevlex). Байты, 
+		которые совпадают у всех мономов, пропускаются. При graded == true
+		дополнительно выполняется сортировка подсчетом по убыванию 
+		степеней. */
+	void _RadixNormalize(bool graded, bool rev)
+	{
+		std::vector<MM<_n>> mons(begin(), end()), buf(mons.size());
+		// байты, которые различаются у мономов
+		MM<_n> mOr(mons[0]), mAnd(mons[0]);
+		for (size_t i = 1; i < mons.size(); ++i)
+			for (size_t pos = 0; pos < mOr.WordSize(); ++pos)
+				mOr.SetWord(pos, mOr.GetWord(pos) | mons[i].GetWord(pos)),
+				mAnd.SetWord(pos, mAnd.GetWord(pos) & mons[i].GetWord(pos));
+		// проходы по байтам
+		const size_t bytes = mOr.WordSize() * sizeof(word);
+		size_t offset[256];
+		for (size_t k = 0; k < bytes; ++k)
+		{
+			size_t i = rev ? bytes - 1 - k : k;
+			size_t pos = i / sizeof(word), shift = 8 * (i % sizeof(word));
+			if (((mOr.GetWord(pos) ^ mAnd.GetWord(pos)) >> shift & 255) == 0)
+				continue;
+			size_t count[256] = {0};
+			for (size_t j = 0; j < mons.size(); ++j)
+				++count[mons[j].GetWord(pos) >> shift & 255];
+			// байты по возрастанию номеров корзин
+			for (size_t r = 0, sum = 0; r < 256; ++r)
+			{
+				size_t b = rev ? RevByte[r] : 255 - r;
+				offset[b] = sum, sum += count[b];
+			}
+			for (size_t j = 0; j < mons.size(); ++j)
+				buf[offset[mons[j].GetWord(pos) >> shift & 255]++] = mons[j];
+			mons.swap(buf);
+		}
+		// проход по степеням
+		if (graded)
+		{
+			std::vector<size_t> degs(mons.size()), count(_n + 2, 0);
+			for (size_t j = 0; j < mons.size(); ++j)
+				++count[_n - (degs[j] = mons[j].Deg()) + 1];
+			for (size_t d = 1; d < count.size(); ++d)
+				count[d] += count[d - 1];
+			for (size_t j = 0; j < mons.size(); ++j)
+				buf[count[_n - degs[j]]++] = mons[j];
+			mons.swap(buf);
+		}
+		// удаление повторов
+		size_t size = 0;
+		for (size_t i = 0; i < mons.size(); ++i)
+			if (i + 1 < mons.size() && mons[i] == mons[i + 1])
+				++i;
+			else
+				mons[size++] = mons[i];
+		assign(mons.begin(), mons.begin() + size);
+	}
+
+	//! Сортировка и удаление повторов в порядке lex
+	void _Normalize(const MOLex<_n>&)
+	{
+		_RadixNormalize(false, false);
+	}
+
+	//! Сортировка и удаление повторов в порядке grlex
+	void _Normalize(const MOGrlex<_n>&)
+	{
+		_RadixNormalize(true, false);
+	}
+
+	//! Сортировка и удаление повторов в порядке grevlex
+	void _Normalize(const MOGrevlex<_n>&)
+	{
+		_RadixNormalize(true, true);
+	}
+
+	//! Сортировка и удаление повторов в общем порядке
+	/*! Мономы сортируются сравнениями. */
+	template<class _O1>
+	void _Normalize(const _O1&)
+	{
 		// сортировка
 		sort(_order);
 		// удаление повторов
@@ -190,6 +277,20 @@ public:
 			else iter = iterNext; 
 	}
 
+public:
+	//! Нормализация
+	/*! Выполняется сортировка мономов по убыванию и удаление пар одинаковых
+		мономов. Многочлены с большим числом мономов в порядках lex, grlex
+		и grevlex сортируются поразрядно (см. _RadixNormalize()), 
+		в остальных случаях -- сравнениями. */
+	void Normalize()
+	{	
+		if (size() < _radixMin)
+			_Normalize<_O>(_order);
+		else
+			_Normalize(_order);
+	}
+
 	//! Нормализован?
 	/*! Проверяется, что мономы не повторяются и отсортированы по убыванию.*/
 	bool IsNormalized() const
@@ -1202,18 +1303,135 @@ public:
 		ReplaceGB(pos, polyReplace);
 	}
 
+	//! Кэш произведений заменяющих многочленов
+	/*! Ключ -- моном из заменяемых переменных, значение -- произведение
+		многочленов, заменяющих его переменные. */
+	typedef std::map<MM<_n>, MP> SubstCache;
+
+	//! Одновременная замена переменных
+	/*! Вхождения переменных с номерами v одновременно заменяются
+		на многочлены subst[v]. Вхождения заменяемых переменных
+		в многочлены subst[v] не заменяются.
+		Мономы группируются по входящим в них заменяемым переменным.
+		Произведение заменяющих многочленов вычисляется один раз для
+		группы и сохраняется в кэше cache. Кэш можно передавать
+		в следующие вызовы с тем же subst. Мономы результата собираются
+		в один массив, который затем упорядочивается, и совпадающие
+		мономы взаимно уничтожаются. */
+	template<class _O1>
+	MP& Substitute(const std::map<size_t, MP<_n, _O1>>& subst,
+		SubstCache* cache = 0)
+	{
+		// заменяемые переменные
+		MM<_n> vars;
+		for (auto iter = subst.begin(); iter != subst.end(); ++iter)
+			vars.Set(iter->first, 1);
+		// мономы: (заменяемая часть, остальная часть)
+		std::vector<MM<_n>> acc;
+		std::vector<std::pair<MM<_n>, MM<_n>>> parts;
+		for (iterator iter = begin(); iter != end(); ++iter)
+		{
+			parts.emplace_back(*iter, *iter);
+			for (size_t pos = 0; pos < vars.WordSize(); ++pos)
+			{
+				parts.back().first.SetWord(pos, 
+					iter->GetWord(pos) & vars.GetWord(pos));
+				parts.back().second.SetWord(pos, 
+					iter->GetWord(pos) & ~vars.GetWord(pos));
+			}
+			if (parts.back().first.IsAllZero())
+				acc.push_back(*iter), parts.pop_back();
+		}
+		if (parts.empty())
+			return *this;
+		// группировка по заменяемым частям
+		std::sort(parts.begin(), parts.end(), 
+			[](const std::pair<MM<_n>, MM<_n>>& p1, 
+				const std::pair<MM<_n>, MM<_n>>& p2)
+			{
+				return p1.first < p2.first;
+			});
+		SubstCache local;
+		if (!cache)
+			cache = &local;
+		const MP* prod = 0;
+		for (size_t i = 0; i < parts.size(); ++i)
+		{
+			if (i == 0 || parts[i].first != parts[i - 1].first)
+				prod = &_SubstProd(parts[i].first, subst, *cache);
+			for (const_iterator m = prod->begin(); m != prod->end(); ++m)
+				acc.push_back(*m), acc.back() *= parts[i].second;
+		}
+		// упорядочение и уничтожение совпадающих мономов
+		std::sort(acc.begin(), acc.end(), _order);
+		size_t size = 0;
+		for (size_t i = 0; i < acc.size(); ++i)
+			if (i + 1 < acc.size() && acc[i] == acc[i + 1])
+				++i;
+			else
+				acc[size++] = acc[i];
+		assign(acc.begin(), acc.begin() + size);
+		return *this;
+	}
+
+protected:
+	//! Произведение заменяющих многочленов
+	/*! Определяется произведение многочленов subst[v] по переменным v
+		монома mon. Произведение строится по произведению для монома 
+		без младшей переменной и сохраняется в cache. */
+	template<class _O1>
+	const MP& _SubstProd(const MM<_n>& mon, 
+		const std::map<size_t, MP<_n, _O1>>& subst, SubstCache& cache) const
+	{
+		auto iter = cache.find(mon);
+		if (iter != cache.end())
+			return iter->second;
+		// младшая переменная
+		size_t pos = 0;
+		while (mon.GetWord(pos) == 0)
+			++pos;
+		size_t v = pos * B_PER_W + WordLoBit(mon.GetWord(pos));
+		MM<_n> rest(mon);
+		rest.Set(v, 0);
+		const MP<_n, _O1>& poly = subst.find(v)->second;
+		MP prod(_order);
+		if (rest.IsAllZero())
+		{
+			prod.assign(poly.begin(), poly.end());
+			prod.Normalize();
+		}
+		else
+			(prod = _SubstProd(rest, subst, cache)) *= poly;
+		return cache.emplace(mon, std::move(prod)).first->second;
+	}
+
+public:
 	//! Замена переменной
 	/*! Выполняется замена вхождений переменной с номером pos 
-		на переменную с номером posNew. */
+		на переменную с номером posNew. 
+		\remark Мономы, которые содержат pos, делятся на x_pos 
+		и переносятся в две серии: с posNew и без posNew. Мономы второй 
+		серии умножаются на x_posNew. Порядок внутри серий сохраняется, 
+		и серии сливаются с многочленом за линейное время. */
 	void Replace(size_t pos, size_t posNew)
 	{	
 		if (pos == posNew)
 			return;
-		for (iterator iter = begin(); iter != end(); ++iter)
+		MP run1(_order), run2(_order);
+		for (iterator iter = begin(), next; iter != end(); iter = next)
+		{
+			++(next = iter);
 			// переменная pos входит в моном *iter?
-			if (iter->Test(pos))
-				iter->Flip(pos), iter->Set(posNew, 1);
-		Normalize();
+			if (!iter->Test(pos))
+				continue;
+			iter->Flip(pos);
+			if (iter->Test(posNew))
+				run1.splice(run1.end(), *this, iter);
+			else
+				iter->Set(posNew, 1), run2.splice(run2.end(), *this, iter);
+		}
+		run1.SymDiffSplice(run2);
+		SymDiffSplice(run1);
 	}
 
 	//! Перестановка переменных
@@ -1240,12 +1458,63 @@ public:
 		}
 		else
 		{
-			for (iterator iter = begin(); iter != end(); ++iter)
-				iter->Set(pos, 0);
-			Normalize();
+			// мономы с переменной pos делятся на x_pos: порядок внутри 
+			// их серии сохраняется
+			MP run(_order);
+			for (iterator iter = begin(), next; iter != end(); iter = next)
+			{
+				++(next = iter);
+				if (iter->Test(pos))
+					iter->Set(pos, 0), run.splice(run.end(), *this, iter);
+			}
+			SymDiffSplice(run);
+		}
+	}
+
+protected:
+	//! Серии мономов
+	/*! Ключ серии -- моном m & t, где m -- моном серии до умножения
+		на моном t. */
+	typedef std::map<MM<_n>, MP> _Runs;
+
+	//! Перенос мономов в серии с умножением
+	/*! Мономы m многочлена poly, начиная с позиции first, умножаются
+		на t и переносятся в серии runs с ключами m & t. Внутри серии 
+		мономы делятся на общий множитель m & t и умножаются на взаимно 
+		простой с ними t, поэтому порядок сохраняется и повторов нет. */
+	static void _SpliceRuns(MP& poly, iterator first, const MM<_n>& t, 
+		_Runs& runs)
+	{
+		MM<_n> key;
+		for (iterator iter = first, next; iter != poly.end(); iter = next)
+		{
+			++(next = iter);
+			for (size_t pos = 0; pos < key.WordSize(); ++pos)
+				key.SetWord(pos, iter->GetWord(pos) & t.GetWord(pos));
+			auto run = runs.find(key);
+			if (run == runs.end())
+				run = runs.emplace(key, MP(poly._order)).first;
+			*iter *= t;
+			run->second.splice(run->second.end(), poly, iter);
 		}
 	}
 
+	//! Слияние серий
+	/*! Серии runs попарно сливаются с взаимным уничтожением совпадающих
+		мономов, результат добавляется к многочлену. */
+	void _MergeRuns(_Runs& runs)
+	{
+		std::vector<MP*> ptrs;
+		for (auto iter = runs.begin(); iter != runs.end(); ++iter)
+			ptrs.push_back(&iter->second);
+		for (size_t step = 1; step < ptrs.size(); step *= 2)
+			for (size_t i = 0; i + step < ptrs.size(); i += 2 * step)
+				ptrs[i]->SymDiffSplice(*ptrs[i + step]);
+		if (!ptrs.empty())
+			SymDiffSplice(*ptrs[0]);
+	}
+
+public:
 	//! S-многочлен
 	/*! Определяется S-многочлен согласованной пары (poly1, poly2)
 		ненулевых многочленов. 
@@ -1255,18 +1524,19 @@ public:
 		// предусловия
 		assert(IsConsistent(poly1) && IsConsistent(poly2));
 		assert(this != &poly1 && this != &poly2);
-		// сбор мономов
-		MM<_n> lm, m;
-		const_iterator iter;
+		// серии мономов
+		MM<_n> lm;
+		MP poly(_order);
+		_Runs runs1, runs2;
 		SetEmpty();
 		lm.LCM(poly1.LM(), poly2.LM()) /= poly1.LM();
-		for (iter = poly1.begin(); ++iter != poly1.end();)
-			push_back((m = *iter) *= lm);
+		insert(end(), ++poly1.begin(), poly1.end());
+		_SpliceRuns(*this, begin(), lm, runs1);
 		lm.LCM(poly1.LM(), poly2.LM()) /= poly2.LM();
-		for (iter = poly2.begin(); ++iter != poly2.end();)
-			push_back((m = *iter) *= lm);
-		// нормализация
-		Normalize();
+		poly.insert(poly.end(), ++poly2.begin(), poly2.end());
+		_SpliceRuns(poly, poly.begin(), lm, runs2);
+		// слияние
+		_MergeRuns(runs1), _MergeRuns(runs2);
 		return *this;
 	}
 
@@ -1278,14 +1548,8 @@ public:
 	{
 		// предусловия
 		assert(this != &poly && IsConsistent(poly));
-		// сбор мономов
-		MM<_n> m;
-		SetEmpty();
-		for (const_iterator iter = poly.begin(); iter != poly.end(); ++iter)
-			(m = *iter).Set(i, 1), push_back(m);
-		// нормализация
-		Normalize();
-		return *this;
+		assign(poly.begin(), poly.end());
+		return SPoly(i);
 	}
 
 	//! S-многочлен
@@ -1295,17 +1559,18 @@ public:
 	{
 		// предусловия
 		assert(IsConsistent(poly) && this != &poly);
-		// сбор мономов
+		// серии мономов
 		MM<_n> lm, m;
+		MP polyTail(_order);
+		_Runs runs1, runs2;
 		(m = lm.LCM(LM(), poly.LM())) /= LM();
 		PopLM();
-		for (iterator iter = begin(); iter != end(); ++iter)
-			*iter *= m;
+		_SpliceRuns(*this, begin(), m, runs1);
 		lm /= poly.LM();
-		for (const_iterator iter = poly.begin(); ++iter != poly.end();)
-			push_back((m = *iter) *= lm);
-		// нормализация
-		Normalize();
+		polyTail.insert(polyTail.end(), ++poly.begin(), poly.end());
+		_SpliceRuns(polyTail, polyTail.begin(), lm, runs2);
+		// слияние
+		_MergeRuns(runs1), _MergeRuns(runs2);
 		return *this;
 	}
 
@@ -1313,9 +1578,16 @@ public:
 	/*! Определяется S-многочлен пары (x_i^2-x_i, *this). */
 	MP& SPoly(size_t i)
 	{
-		for (iterator iter = begin(); iter != end(); ++iter)
-			iter->Set(i, 1);
-		Normalize();
+		// мономы без x_i умножаются на x_i: порядок внутри их серии 
+		// сохраняется
+		MP run(_order);
+		for (iterator iter = begin(), next; iter != end(); iter = next)
+		{
+			++(next = iter);
+			if (!iter->Test(i))
+				iter->Set(i, 1), run.splice(run.end(), *this, iter);
+		}
+		SymDiffSplice(run);
 		return *this;
 	}
 
@@ -1325,11 +1597,12 @@ public:
 	/*! Выполняется умножение на моном mRight. */
 	MP& operator*=(const MM<_n>& mRight)
 	{	
-		for (iterator iter = begin(); iter != end(); ++iter)
-			(*iter) *= mRight;
 		// при умножении могут появиться повторяющиеся мономы 
-		// и может нарушиться порядок
-		Normalize();
+		// и может нарушиться порядок, но только между сериями мономов
+		// с разными общими частями с mRight
+		_Runs runs;
+		_SpliceRuns(*this, begin(), mRight, runs);
+		_MergeRuns(runs);
 		return *this;
 	}
 
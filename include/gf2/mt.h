@@ -0,0 +1,474 @@
+/*
+*******************************************************************************
+\file mt.h
+\brief Monomial tables
+\project GF2 [algebra over GF(2)]
+\created 2026.10.17
+\version 2026.10.17
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file mt.h
+\brief Словари мономов
+
+Модуль содержит описание и реализацию класса MT (словарь мономов, который
+назначает мономам целочисленные номера), класса MTRank (ранги номеров
+в мономиальном порядке) и класса MTP (многочлены над номерами мономов).
+*******************************************************************************
+*/
+
+#ifndef __GF2_MT
+#define __GF2_MT
+
+#include "gf2/mp.h"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс MT
+
+Словарь мономов: каждому добавленному моному назначается номер (32-битовый
+идентификатор) -- порядковый номер добавления. Равные мономы получают
+равные номера, поэтому сравнение мономов на равенство сводится
+к сравнению номеров.
+
+Словарь -- хэш-таблица с открытой адресацией (линейное пробирование),
+ячейки которой содержат номера. Мономы хранятся в блоках, размеры которых
+удваиваются. Блоки не перемещаются, поэтому моном по номеру (метод Get())
+возвращается без блокировок.
+
+Словарь допускает одновременное использование несколькими потоками:
+поиск (Find(), Insert()) выполняется под разделяемой блокировкой,
+добавление -- под исключительной.
+\code
+	MT<n> table;
+	MT<n>::Id id = table.Insert(m);
+	assert(table.Get(id) == m);
+\endcode
+*******************************************************************************
+*/
+
+template<size_t _n> class MT
+{
+public:
+	//! Номер монома
+	typedef uint32_t Id;
+	//! Отсутствующий номер
+	static constexpr Id None = UINT32_MAX;
+
+protected:
+	static const size_t _log0 = 8; //< логарифм размера первого блока
+	static const size_t _blocks = 32 - _log0; //< наибольшее число блоков
+
+	std::unique_ptr<MM<_n>[]> _mons[_blocks]; //< блоки мономов
+	std::vector<Id> _slots; //< ячейки хэш-таблицы
+	size_t _size; //< число мономов
+	mutable std::shared_mutex _lock; //< блокировка
+
+	//! Хэш монома
+	static size_t _Hash(const MM<_n>& m)
+	{
+		size_t h = 0;
+		for (size_t pos = 0; pos < m.WordSize(); ++pos)
+			h = (h ^ size_t(m.GetWord(pos))) *
+				size_t(0x9E3779B97F4A7C15ull) + (h >> 29);
+		return h ^ h >> (4 * sizeof(size_t));
+	}
+
+	//! Ячейка монома
+	/*! Определяется ячейка, которая содержит номер монома m,
+		или первая пустая ячейка на пути пробирования. */
+	size_t _Slot(const MM<_n>& m) const
+	{
+		size_t mask = _slots.size() - 1;
+		size_t slot = _Hash(m) & mask;
+		while (_slots[slot] != None && Get(_slots[slot]) != m)
+			slot = (slot + 1) & mask;
+		return slot;
+	}
+
+	//! Расширение хэш-таблицы
+	/*! Ячейки хэш-таблицы перестраиваются так, чтобы их число
+		было не меньше удвоенного числа мономов count. */
+	void _Rehash(size_t count)
+	{
+		size_t cap = 16;
+		while (cap < 2 * count)
+			cap *= 2;
+		if (cap <= _slots.size())
+			return;
+		_slots.assign(cap, None);
+		for (size_t id = 0; id < _size; ++id)
+			_slots[_Slot(Get(Id(id)))] = Id(id);
+	}
+
+	//! Блок и позиция в блоке
+	static void _Locate(size_t id, size_t& block, size_t& pos)
+	{
+		size_t i = id + (size_t(1) << _log0), hi = 0;
+		while (i >> hi >> 1)
+			++hi;
+		block = hi - _log0, pos = i - (size_t(1) << hi);
+	}
+
+public:
+	//! Поиск
+	/*! Определяется номер монома m.
+		\return Номер или None, если m не добавлен в словарь. */
+	Id Find(const MM<_n>& m) const
+	{
+		std::shared_lock<std::shared_mutex> guard(_lock);
+		return _slots.empty() ? None : _slots[_Slot(m)];
+	}
+
+	//! Добавление
+	/*! Определяется номер монома m. Если моном не добавлен в словарь,
+		то он добавляется. */
+	Id Insert(const MM<_n>& m)
+	{
+		Id id = Find(m);
+		if (id != None)
+			return id;
+		std::unique_lock<std::shared_mutex> guard(_lock);
+		_Rehash(_size + 1);
+		size_t slot = _Slot(m);
+		if (_slots[slot] != None)
+			return _slots[slot];
+		assert(_size < None);
+		size_t block, pos;
+		_Locate(_size, block, pos);
+		if (!_mons[block])
+			_mons[block].reset(new MM<_n>[size_t(1) << (block + _log0)]);
+		_mons[block][pos] = m;
+		return _slots[slot] = Id(_size++);
+	}
+
+	//! Моном по номеру
+	/*! \pre Номер id выдан словарем. */
+	const MM<_n>& Get(Id id) const
+	{
+		size_t block, pos;
+		_Locate(id, block, pos);
+		return _mons[block][pos];
+	}
+
+	//! Число мономов
+	size_t Size() const
+	{
+		std::shared_lock<std::shared_mutex> guard(_lock);
+		return _size;
+	}
+
+	//! Резервирование
+	/*! Хэш-таблица подготавливается к хранению count мономов. */
+	void Reserve(size_t count)
+	{
+		std::unique_lock<std::shared_mutex> guard(_lock);
+		_Rehash(count);
+	}
+
+	//! Очистка
+	void Clear()
+	{
+		std::unique_lock<std::shared_mutex> guard(_lock);
+		for (size_t block = 0; block < _blocks; ++block)
+			_mons[block].reset();
+		_slots.clear(), _size = 0;
+	}
+
+	//! Конструктор
+	MT() : _size(0)
+	{
+	}
+
+	MT(const MT&) = delete;
+	MT& operator=(const MT&) = delete;
+};
+
+/*!
+*******************************************************************************
+Класс MTRank
+
+Ранги номеров словаря MT в мономиальном порядке _O: m1 > m2 тогда и только
+тогда, когда ранг номера m1 больше ранга номера m2. Сравнение мономов
+сводится к сравнению рангов.
+
+Ранги пересчитываются явно методом Update() -- один раз после этапа
+добавления мономов в словарь: новые номера упорядочиваются и сливаются
+с упорядоченными ранее. Взаимный порядок рангов при пересчете сохраняется.
+Пересчет требует O(N) операций, где N -- число мономов словаря, поэтому
+его не следует выполнять после каждого добавления.
+
+Между пересчетами ранги только читаются, и один объект MTRank может
+использоваться несколькими потоками одновременно. Пересчет выполняется
+одним потоком, когда остальные потоки не обращаются к рангам.
+*******************************************************************************
+*/
+
+template<size_t _n, class _O> class MTRank
+{
+public:
+	typedef typename MT<_n>::Id Id;
+
+protected:
+	const MT<_n>& _table; //< словарь
+	_O _order; //< мономиальный порядок
+	std::vector<Id> _sorted; //< номера по возрастанию
+	std::vector<uint32_t> _rank; //< ранги номеров
+
+public:
+	//! Пересчет
+	/*! Ранги пересчитываются, если в словарь добавлены мономы. 
+		\remark Пересчет не допускает одновременных обращений к рангам. */
+	void Update()
+	{
+		size_t size = _table.Size();
+		if (size == _rank.size())
+			return;
+		auto less = [&](Id id1, Id id2)
+		{
+			return _order(_table.Get(id2), _table.Get(id1));
+		};
+		size_t old = _sorted.size();
+		for (size_t id = old; id < size; ++id)
+			_sorted.push_back(Id(id));
+		std::sort(_sorted.begin() + old, _sorted.end(), less);
+		std::inplace_merge(_sorted.begin(), _sorted.begin() + old,
+			_sorted.end(), less);
+		_rank.resize(size);
+		for (size_t r = 0; r < size; ++r)
+			_rank[_sorted[r]] = uint32_t(r);
+	}
+
+	//! Ранг
+	/*! \pre Ранг id вычислен (см. Update()). */
+	uint32_t operator[](Id id) const
+	{
+		assert(id < _rank.size());
+		return _rank[id];
+	}
+
+	//! Ранг вычислен?
+	bool IsRanked(Id id) const
+	{
+		return id < _rank.size();
+	}
+
+	//! Ранги актуальны?
+	/*! Проверяется, что ранги вычислены для всех номеров словаря. */
+	bool IsCurrent() const
+	{
+		return _rank.size() == _table.Size();
+	}
+
+	//! Сравнение
+	/*! \return Признак того, что моном с номером id1 больше монома
+		с номером id2. */
+	bool operator()(Id id1, Id id2) const
+	{
+		return (*this)[id1] > (*this)[id2];
+	}
+
+	//! Словарь
+	const MT<_n>& GetTable() const
+	{
+		return _table;
+	}
+
+	//! Мономиальный порядок
+	const _O& GetOrder() const
+	{
+		return _order;
+	}
+
+	//! Конструктор
+	MTRank(const MT<_n>& table, const _O& order = _O()) :
+		_table(table), _order(order)
+	{
+	}
+};
+
+/*!
+*******************************************************************************
+Класс MTP
+
+Многочлен над номерами мономов: номера мономов словаря MT упорядочены
+по убыванию в порядке _O (по убыванию рангов MTRank). Многочлен
+соответствует многочлену MP с тем же порядком.
+
+Сравнение многочленов на равенство сводится к сравнению номеров,
+при сложении мономы сравниваются по рангам. Сложение не пересчитывает
+ранги: они должны быть вычислены для всех мономов слагаемых (см.
+MTRank::Update()). При умножении на моном ранги не используются, поэтому
+умножения можно выполнять до пересчета.
+\code
+	MT<n> table;
+	MTRank<n, O> rank(table);
+	MTP<n, O> p1(table, rank), p2(table, rank);
+	p1.From(poly1), p2.From(poly2);
+	p2 *= m;
+	rank.Update();
+	p1 += p2;
+	p1.To(poly1);
+\endcode
+*******************************************************************************
+*/
+
+template<size_t _n, class _O> class MTP : public std::vector<typename MT<_n>::Id>
+{
+public:
+	typedef typename MT<_n>::Id Id;
+
+protected:
+	MT<_n>* _table; //< словарь
+	MTRank<_n, _O>* _rank; //< ранги
+
+	//! Ранги мономов вычислены?
+	bool _IsRanked() const
+	{
+		for (Id id : *this)
+			if (!_rank->IsRanked(id))
+				return false;
+		return true;
+	}
+
+	//! Слияние серий
+	/*! Упорядоченные серии run1 и run2 сливаются с взаимным уничтожением 
+		совпадающих номеров, результат записывается в run1. Мономы
+		сравниваются в порядке _O, ранги не используются. */
+	void _MergeRuns(std::vector<Id>& run1, const std::vector<Id>& run2,
+		std::vector<Id>& buf) const
+	{
+		const _O& order = _rank->GetOrder();
+		buf.clear();
+		buf.reserve(run1.size() + run2.size());
+		auto i1 = run1.cbegin(), i2 = run2.cbegin();
+		while (i1 != run1.cend() && i2 != run2.cend())
+			if (*i1 == *i2)
+				++i1, ++i2;
+			else if (order(_table->Get(*i1), _table->Get(*i2)))
+				buf.push_back(*i1++);
+			else
+				buf.push_back(*i2++);
+		buf.insert(buf.end(), i1, run1.cend());
+		buf.insert(buf.end(), i2, run2.cend());
+		run1.swap(buf);
+	}
+
+public:
+	//! Загрузка
+	/*! Многочлен определяется по многочлену poly. Мономы poly
+		добавляются в словарь. */
+	MTP& From(const MP<_n, _O>& poly)
+	{
+		this->clear();
+		this->reserve(poly.Size());
+		for (auto iter = poly.begin(); iter != poly.end(); ++iter)
+			this->push_back(_table->Insert(*iter));
+		return *this;
+	}
+
+	//! Выгрузка
+	/*! Многочлен преобразуется в многочлен poly. */
+	MP<_n, _O>& To(MP<_n, _O>& poly) const
+	{
+		poly.SetEmpty();
+		poly.SetOrder(_rank->GetOrder());
+		for (Id id : *this)
+			poly.push_back(_table->Get(id));
+		return poly;
+	}
+
+	//! Старший моном
+	/*! \pre Многочлен ненулевой. */
+	Id LM() const
+	{
+		assert(!this->empty());
+		return this->front();
+	}
+
+	//! Сложение
+	/*! К многочлену добавляется многочлен polyRight: совпадающие
+		мономы взаимно уничтожаются. 
+		\pre Ранги мономов обоих многочленов вычислены. */
+	MTP& operator+=(const MTP& polyRight)
+	{
+		assert(_table == polyRight._table && _rank == polyRight._rank);
+		assert(_IsRanked() && polyRight._IsRanked());
+		std::vector<Id> sum;
+		sum.reserve(this->size() + polyRight.size());
+		auto i1 = this->begin(), i2 = polyRight.begin();
+		while (i1 != this->end() && i2 != polyRight.end())
+		{
+			uint32_t r1 = (*_rank)[*i1], r2 = (*_rank)[*i2];
+			if (r1 > r2)
+				sum.push_back(*i1++);
+			else if (r1 < r2)
+				sum.push_back(*i2++);
+			else
+				++i1, ++i2;
+		}
+		sum.insert(sum.end(), i1, this->end());
+		sum.insert(sum.end(), i2, polyRight.end());
+		this->swap(sum);
+		return *this;
+	}
+
+	//! Умножение на моном
+	/*! Многочлен умножается на моном m. Мономы произведения
+		добавляются в словарь, ранги не пересчитываются.
+		\remark Умножение на m -- это НОК с m, которое сохраняет порядок 
+		только среди мономов t с одинаковым t & m. Произведения 
+		распределяются по сериям с ключами t & m, внутри серии порядок 
+		сохраняется и повторов нет. Серии попарно сливаются 
+		(как в MP::operator*=()). */
+	MTP& operator*=(const MM<_n>& m)
+	{
+		std::map<MM<_n>, std::vector<Id>> runs;
+		MM<_n> key, t;
+		for (Id id : *this)
+		{
+			const MM<_n>& s = _table->Get(id);
+			for (size_t pos = 0; pos < key.WordSize(); ++pos)
+				key.SetWord(pos, s.GetWord(pos) & m.GetWord(pos));
+			(t = s) *= m;
+			runs[key].push_back(_table->Insert(t));
+		}
+		this->clear();
+		if (runs.empty())
+			return *this;
+		std::vector<std::vector<Id>*> ptrs;
+		for (auto iter = runs.begin(); iter != runs.end(); ++iter)
+			ptrs.push_back(&iter->second);
+		std::vector<Id> buf;
+		for (size_t step = 1; step < ptrs.size(); step *= 2)
+			for (size_t i = 0; i + step < ptrs.size(); i += 2 * step)
+				_MergeRuns(*ptrs[i], *ptrs[i + step], buf);
+		this->swap(*ptrs[0]);
+		return *this;
+	}
+
+	//! Конструктор
+	/*! Создается нулевой многочлен над словарем table с рангами rank.
+		\pre rank построен по table. */
+	MTP(MT<_n>& table, MTRank<_n, _O>& rank) : _table(&table), _rank(&rank)
+	{
+		assert(&rank.GetTable() == &table);
+	}
+};
+
+} // namespace GF2
+
+#endif // __GF2_MT
@@ -0,0 +1,245 @@
+/*
+*******************************************************************************
+\file pool.h
+\brief A work-stealing thread pool
+\project GF2 [algebra over GF(2)]
+\created 2026.10.16
+\version 2026.10.16
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file pool.h
+\brief Пул потоков
+
+Модуль содержит описание и реализацию класса Pool -- пула потоков
+с перехватом работы (work stealing).
+*******************************************************************************
+*/
+
+#ifndef __GF2_POOL
+#define __GF2_POOL
+
+#include "gf2/defs.h"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс Pool
+
+Пул из Size() исполнителей: вызывающего потока (исполнитель 0)
+и Size() - 1 рабочих потоков, которые создаются в конструкторе
+и ожидают заданий.
+
+Задание Run(count, f) -- это вызовы f(worker, task) для всех task
+из [0, count), где worker -- номер исполнителя. Номера задач сначала
+делятся между исполнителями на равные непрерывные отрезки. Исполнитель
+выбирает задачи с начала своего отрезка, а исчерпав его, перехватывает
+вторую половину отрезка другого исполнителя. Поэтому неравные по сложности
+задачи распределяются равномерно, а соседние задачи обычно решаются одним
+исполнителем.
+
+Run() возвращает управление после решения всех задач. Если f выбрасывает
+исключение, то оставшиеся задачи не решаются, а первое исключение
+передается вызывающему потоку.
+
+\warning Вложенные вызовы Run() и вызовы Run() из разных потоков
+одновременно не поддерживаются.
+*******************************************************************************
+*/
+
+class Pool
+{
+	//! Отрезок задач исполнителя
+	struct _Range
+	{
+		std::mutex lock; //< блокировка
+		size_t begin; //< первая задача
+		size_t end; //< граница задач
+	};
+
+	std::vector<std::thread> _threads; //< рабочие потоки
+	std::unique_ptr<_Range[]> _ranges; //< отрезки исполнителей
+	std::mutex _lock; //< блокировка состояния
+	std::condition_variable _start; //< сигнал начала задания
+	std::condition_variable _done; //< сигнал завершения задания
+	std::function<void(size_t, size_t)> _job; //< текущее задание
+	size_t _gen; //< номер задания
+	size_t _active; //< число занятых рабочих потоков
+	bool _stop; //< признак остановки
+	std::exception_ptr _error; //< первое исключение
+
+	//! Выбор задачи
+	/*! Исполнитель worker выбирает задачу из своего отрезка
+		или перехватывает задачи других исполнителей.
+		\return Номер задачи или SIZE_MAX, если задач не осталось. */
+	size_t _Next(size_t worker)
+	{
+		_Range& own = _ranges[worker];
+		{
+			std::lock_guard<std::mutex> guard(own.lock);
+			if (own.begin < own.end)
+				return own.begin++;
+		}
+		// перехват: вторая половина самого длинного чужого отрезка
+		while (1)
+		{
+			size_t victim = SIZE_MAX, len = 0;
+			for (size_t i = 0; i < Size(); ++i)
+				if (i != worker)
+				{
+					std::lock_guard<std::mutex> guard(_ranges[i].lock);
+					if (_ranges[i].end - _ranges[i].begin > len)
+						victim = i, len = _ranges[i].end - _ranges[i].begin;
+				}
+			if (victim == SIZE_MAX)
+				return SIZE_MAX;
+			size_t begin, end;
+			{
+				std::lock_guard<std::mutex> guard(_ranges[victim].lock);
+				end = _ranges[victim].end;
+				begin = _ranges[victim].begin;
+				// отрезок уже сократился?
+				if (begin == end)
+					continue;
+				begin += (end - begin) / 2;
+				_ranges[victim].end = begin;
+			}
+			std::lock_guard<std::mutex> guard(own.lock);
+			own.begin = begin + 1, own.end = end;
+			return begin;
+		}
+	}
+
+	//! Решение задач
+	/*! Исполнитель worker решает задачи текущего задания. */
+	void _Work(size_t worker)
+	{
+		for (size_t task; (task = _Next(worker)) != SIZE_MAX;)
+			try
+			{
+				_job(worker, task);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> guard(_lock);
+				if (!_error)
+					_error = std::current_exception();
+				// отказаться от оставшихся задач
+				for (size_t i = 0; i < Size(); ++i)
+				{
+					std::lock_guard<std::mutex> guard(_ranges[i].lock);
+					_ranges[i].begin = _ranges[i].end;
+				}
+			}
+	}
+
+	//! Цикл рабочего потока
+	void _Loop(size_t worker)
+	{
+		size_t gen = 0;
+		while (1)
+		{
+			{
+				std::unique_lock<std::mutex> guard(_lock);
+				_start.wait(guard, [&] { return _stop || _gen != gen; });
+				if (_stop)
+					return;
+				gen = _gen;
+			}
+			_Work(worker);
+			std::lock_guard<std::mutex> guard(_lock);
+			if (--_active == 0)
+				_done.notify_one();
+		}
+	}
+
+public:
+	//! Число исполнителей
+	size_t Size() const
+	{
+		return _threads.size() + 1;
+	}
+
+	//! Выполнение задания
+	/*! Для всех task из [0, count) выполняются вызовы f(worker, task),
+		где worker < Size() -- номер исполнителя. Вызовы f одним
+		исполнителем последовательны. */
+	template<class _F>
+	void Run(size_t count, _F&& f)
+	{
+		if (count == 0)
+			return;
+		// распределить задачи
+		for (size_t i = 0; i < Size(); ++i)
+		{
+			std::lock_guard<std::mutex> guard(_ranges[i].lock);
+			_ranges[i].begin = count * i / Size();
+			_ranges[i].end = count * (i + 1) / Size();
+		}
+		// запустить рабочие потоки
+		{
+			std::lock_guard<std::mutex> guard(_lock);
+			_job = std::ref(f);
+			_error = nullptr;
+			_active = _threads.size();
+			++_gen;
+		}
+		_start.notify_all();
+		// решать задачи
+		_Work(0);
+		// дождаться рабочих потоков
+		std::unique_lock<std::mutex> guard(_lock);
+		_done.wait(guard, [&] { return _active == 0; });
+		_job = nullptr;
+		if (_error)
+			std::rethrow_exception(_error);
+	}
+
+// конструирование
+public:
+	//! Конструктор
+	/*! Создается пул из threads исполнителей. При threads == 0 число
+		исполнителей совпадает с числом аппаратных потоков. */
+	explicit Pool(size_t threads = 0) : _gen(0), _active(0), _stop(false)
+	{
+		if (threads == 0)
+			threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+		_ranges.reset(new _Range[threads]);
+		for (size_t i = 0; i < threads; ++i)
+			_ranges[i].begin = _ranges[i].end = 0;
+		for (size_t i = 1; i < threads; ++i)
+			_threads.emplace_back(&Pool::_Loop, this, i);
+	}
+
+	//! Деструктор
+	~Pool()
+	{
+		{
+			std::lock_guard<std::mutex> guard(_lock);
+			_stop = true;
+		}
+		_start.notify_all();
+		for (auto iter = _threads.begin(); iter != _threads.end(); ++iter)
+			iter->join();
+	}
+
+	Pool(const Pool&) = delete;
+	Pool& operator=(const Pool&) = delete;
+};
+
+} // namespace GF2
+
+#endif // __GF2_POOL
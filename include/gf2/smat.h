@@ -0,0 +1,837 @@
+/*
+*******************************************************************************
+\file smat.h
+\brief Sparse matrices over GF(2)
+\project GF2 [algebra over GF(2)]
+\created 2026.10.16
+\version 2026.10.16
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file smat.h
+\brief Разреженные матрицы над GF(2)
+
+Модуль содержит описание и реализацию класса SMat, который представляет
+разреженные матрицы над GF(2), в частности, матрицы Маколея систем
+многочленов.
+*******************************************************************************
+*/
+
+#ifndef __GF2_SMAT
+#define __GF2_SMAT
+
+#include "gf2/mat.h"
+#include "gf2/mi.h"
+#include "gf2/pool.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс SMat
+
+Разреженная матрица над GF(2), размеры которой задаются при выполнении.
+Строка хранится как возрастающий список номеров столбцов, в которых стоят
+ненулевые элементы.
+
+Матрица строится по системе многочленов (см. From()): строки соответствуют
+многочленам, столбцы -- мономам системы, упорядоченным по убыванию
+в мономиальном порядке системы. В такой матрице Маколея мало ненулевых
+элементов: строка содержит столько элементов, сколько мономов
+в многочлене, тогда как столбцов может быть миллионы.
+
+Ранг, решения систем и базис пересечения пространства строк с младшими
+столбцами (см. Rank(), Solve(), Tail()) определяются структурированным
+исключением (structured Gaussian elimination, LaMacchia, Odlyzko, 1990).
+Сначала опорными выбираются столбцы с наименьшим числом ненулевых
+элементов, а в столбце -- самая короткая строка (стратегия Марковица,
+минимизирующая заполнение). Исключение продолжается, пока столбцы
+достаточно разрежены и заполнение не слишком велико. Оставшаяся
+подматрица переносится в плотную матрицу Mat и приводится методом
+четырех русских.
+
+Векторы ядра (см. Kernel()) находятся блочным методом Ланцоша
+(Montgomery, 1995) для симметричной матрицы A^T A, который использует
+только умножения матрицы на блоки векторов. Блок из B_PER_W векторов
+хранится как массив машинных слов, и умножение матрицы на блок (см.
+MultBlock()) стоит столько же, сколько умножение на один вектор.
+Метод выполняет около Cols() / (B_PER_W - 0.76) итераций, на каждой --
+одно умножение на A^T A и несколько произведений блоков на матрицы
+B_PER_W x B_PER_W. Умножения выполняются параллельно по группам строк
+на исполнителях пула Pool.
+
+Векторы над GF(2) упакованы в слова так же, как строки Mat: символ i --
+это бит i % B_PER_W слова i / B_PER_W.
+*******************************************************************************
+*/
+
+class SMat
+{
+	size_t _cols; //< число столбцов
+	std::vector<std::vector<size_t>> _rows; //< номера ненулевых столбцов
+
+	//! Наибольшее число элементов в опорном столбце
+	static constexpr size_t _maxCount = 32;
+	//! Наибольшее заполнение (во сколько раз может вырасти число элементов)
+	static constexpr size_t _maxFill = 3;
+	//! Число строк в группе при умножении
+	static constexpr size_t _chunk = 1024;
+
+	//! Результат структурированного исключения
+	struct _Elim
+	{
+		std::vector<size_t> cols; //< опорные столбцы (в порядке выбора)
+		std::vector<std::vector<size_t>> rows; //< опорные строки
+		std::vector<size_t> dcols; //< столбцы плотной подматрицы
+		Mat dense; //< плотная подматрица в приведенном ступенчатом виде
+		size_t rank; //< ранг плотной подматрицы
+	};
+
+	//! Структурированное исключение
+	/*! Исключаются строки rows, в которых помимо столбцов 0,..., _cols - 1
+		может встречаться фиктивный столбец _cols (правая часть системы).
+		Опорными выбираются только столбцы 0, 1,..., first - 1.
+		Опорная строка с опорным столбцом c прибавляется к остальным
+		строкам, которые содержат c, и исключается. Поэтому опорная
+		строка содержит только свой опорный столбец, столбцы,
+		выбранные позже, и столбцы плотной подматрицы. Плотная
+		подматрица составляется из оставшихся строк, ее столбцы
+		dcols упорядочены по возрастанию. При rhs == true к ним
+		добавляется столбец правой части. */
+	void _Eliminate(std::vector<std::vector<size_t>>& rows, size_t first,
+		bool rhs, _Elim& e, Pool* pool) const
+	{
+		// число элементов в столбцах и строки, которые их содержат
+		// (в списках могут остаться строки, которые уже не содержат столбец,
+		// и повторы строк, в которые столбец вернулся при заполнении)
+		std::vector<size_t> count(_cols, 0);
+		std::vector<std::vector<size_t>> where(_cols);
+		std::vector<bool> active(rows.size(), true), done(_cols, false);
+		std::vector<size_t> seen(rows.size(), SIZE_MAX);
+		size_t weight = 0;
+		for (size_t i = 0; i < rows.size(); ++i)
+			for (size_t j : rows[i])
+				if (j < _cols)
+					++count[j], where[j].push_back(i), ++weight;
+		const size_t limit = _maxFill * weight + _cols;
+		// очередь столбцов по возрастанию числа элементов
+		typedef std::pair<size_t, size_t> _Item;
+		std::priority_queue<_Item, std::vector<_Item>, std::greater<_Item>> queue;
+		for (size_t j = 0; j < first && j < _cols; ++j)
+			if (count[j])
+				queue.emplace(count[j], j);
+		e.cols.clear(), e.rows.clear();
+		std::vector<size_t> tmp;
+		while (!queue.empty() && weight <= limit)
+		{
+			size_t c = queue.top().second;
+			if (done[c] || queue.top().first != count[c])
+			{
+				queue.pop();
+				continue;
+			}
+			if (count[c] > _maxCount)
+				break;
+			queue.pop();
+			if (count[c] == 0)
+				continue;
+			// опорная строка: самая короткая
+			size_t p = SIZE_MAX;
+			auto& list = where[c];
+			size_t t = 0;
+			for (size_t i : list)
+				if (active[i] && seen[i] != c && std::binary_search(
+					rows[i].begin(), rows[i].end(), c))
+				{
+					seen[i] = c;
+					list[t++] = i;
+					if (p == SIZE_MAX || rows[i].size() < rows[p].size())
+						p = i;
+				}
+			list.resize(t);
+			assert(p != SIZE_MAX);
+			// исключение столбца c из остальных строк
+			const std::vector<size_t>& piv = rows[p];
+			for (size_t l = 0; l < t; ++l)
+			{
+				size_t i = list[l];
+				if (i == p)
+					continue;
+				tmp.clear();
+				auto a = rows[i].cbegin(), b = piv.cbegin();
+				while (a != rows[i].end() || b != piv.end())
+					if (b == piv.end() || (a != rows[i].end() && *a < *b))
+						tmp.push_back(*a++);
+					else if (a == rows[i].end() || *b < *a)
+					{
+						if (*b < _cols)
+						{
+							++count[*b], ++weight, where[*b].push_back(i);
+							if (*b < first && !done[*b])
+								queue.emplace(count[*b], *b);
+						}
+						tmp.push_back(*b++);
+					}
+					else
+					{
+						if (*b < _cols)
+						{
+							--count[*b], weight -= 2;
+							if (*b < first && !done[*b])
+								queue.emplace(count[*b], *b);
+						}
+						++a, ++b;
+					}
+				rows[i].swap(tmp);
+			}
+			// исключение опорной строки
+			for (size_t j : piv)
+				if (j < _cols)
+				{
+					--count[j], --weight;
+					if (j < first && !done[j])
+						queue.emplace(count[j], j);
+				}
+			active[p] = false, done[c] = true;
+			e.cols.push_back(c);
+			e.rows.emplace_back();
+			e.rows.back().swap(rows[p]);
+			list.clear();
+		}
+		// плотная подматрица
+		std::vector<size_t> index(_cols + 1, SIZE_MAX);
+		size_t dr = 0;
+		e.dcols.clear();
+		for (size_t j = 0; j < _cols; ++j)
+			if (count[j])
+				index[j] = e.dcols.size(), e.dcols.push_back(j);
+		index[_cols] = e.dcols.size();
+		for (size_t i = 0; i < rows.size(); ++i)
+			if (active[i] && !rows[i].empty())
+				++dr;
+		e.dense.Resize(dr, e.dcols.size() + (rhs ? 1 : 0));
+		dr = 0;
+		for (size_t i = 0; i < rows.size(); ++i)
+			if (active[i] && !rows[i].empty())
+			{
+				for (size_t j : rows[i])
+					e.dense.Flip(dr, index[j]);
+				++dr;
+			}
+		e.rank = pool ? e.dense.Echelon(*pool) : e.dense.Echelon();
+	}
+
+	//! Умножение на блок векторов
+	/*! Определяется y = Ax, где A -- матрица *this, x -- блок векторов
+		из Cols() слов, y -- блок из Rows() слов. */
+	void _MultBlock(const word* x, word* y, Pool* pool) const
+	{
+		auto body = [&](size_t, size_t task)
+		{
+			size_t last = std::min(_rows.size(), (task + 1) * _chunk);
+			for (size_t i = task * _chunk; i < last; ++i)
+			{
+				word w = 0;
+				for (size_t j : _rows[i])
+					w ^= x[j];
+				y[i] = w;
+			}
+		};
+		size_t tasks = (_rows.size() + _chunk - 1) / _chunk;
+		if (pool && tasks > 1)
+			pool->Run(tasks, body);
+		else
+			for (size_t task = 0; task < tasks; ++task)
+				body(0, task);
+	}
+
+	//! Извлечение полосы
+	/*! Вектор полосы lane блока block упаковывается в vec. */
+	static void _Lane(const std::vector<word>& block, size_t lane,
+		std::vector<word>& vec)
+	{
+		vec.assign((block.size() + B_PER_W - 1) / B_PER_W, 0);
+		for (size_t j = 0; j < block.size(); ++j)
+			vec[j / B_PER_W] |= (block[j] >> lane & 1) << j % B_PER_W;
+	}
+
+	//! Малая матрица
+	/*! Матрица B_PER_W x B_PER_W: слово i -- строка i. */
+	typedef word _Small[B_PER_W];
+
+	//! Число байтов в слове
+	static constexpr size_t _bytes = B_PER_W / 8;
+
+	//! Число слов блока в задаче
+	static constexpr size_t _span = 16384;
+
+	//! Обработка частей блока
+	/*! Слова 0, 1,..., count - 1 блока делятся на части по _span слов,
+		и для каждой части [begin, end) вызывается body(task, begin, end).
+		Части обрабатываются на исполнителях pool (если pool != 0). */
+	template<class _Body>
+	static void _Split(size_t count, Pool* pool, _Body body)
+	{
+		size_t tasks = (count + _span - 1) / _span;
+		auto run = [&](size_t, size_t task)
+		{
+			body(task, task * _span, std::min(count, (task + 1) * _span));
+		};
+		if (pool && tasks > 1)
+			pool->Run(tasks, run);
+		else
+			for (size_t task = 0; task < tasks; ++task)
+				run(0, task);
+	}
+
+	//! Скалярное произведение блоков
+	/*! Определяется c = X^T Y, где X и Y -- блоки векторов из count слов.
+		Слова y[k] накапливаются в таблицах по байтам x[k]: по одному
+		сложению на байт вместо сложения на бит. */
+	static void _Inner(const word* x, const word* y, size_t count, _Small c,
+		Pool* pool)
+	{
+		std::vector<word> parts((count + _span - 1) / _span * B_PER_W);
+		_Split(count, pool, [&](size_t task, size_t begin, size_t end)
+		{
+			word table[_bytes][256] = {};
+			for (size_t k = begin; k < end; ++k)
+				for (size_t b = 0; b < _bytes; ++b)
+					table[b][x[k] >> 8 * b & 255] ^= y[k];
+			word* part = parts.data() + task * B_PER_W;
+			for (size_t b = 0; b < _bytes; ++b)
+				for (size_t i = 0; i < 8; ++i)
+				{
+					word w = 0;
+					for (size_t v = 0; v < 256; ++v)
+						if (v >> i & 1)
+							w ^= table[b][v];
+					part[8 * b + i] = w;
+				}
+		});
+		std::fill(c, c + B_PER_W, 0);
+		for (size_t pos = 0; pos < parts.size(); ++pos)
+			c[pos % B_PER_W] ^= parts[pos];
+	}
+
+	//! Умножение блока на малую матрицу
+	/*! Выполняется Y += X c, где X и Y -- блоки векторов из count слов.
+		Комбинации строк c заранее вычисляются для всех значений байтов. */
+	static void _MultSmall(const word* x, const _Small c, word* y,
+		size_t count, Pool* pool)
+	{
+		word table[_bytes][256];
+		for (size_t b = 0; b < _bytes; ++b)
+		{
+			table[b][0] = 0;
+			for (size_t v = 1; v < 256; ++v)
+				table[b][v] = table[b][v & (v - 1)] ^ 
+					c[8 * b + WordLoBit(word(v))];
+		}
+		_Split(count, pool, [&](size_t, size_t begin, size_t end)
+		{
+			for (size_t k = begin; k < end; ++k)
+			{
+				word w = y[k];
+				for (size_t b = 0; b < _bytes; ++b)
+					w ^= table[b][x[k] >> 8 * b & 255];
+				y[k] = w;
+			}
+		});
+	}
+
+	//! Произведение малых матриц
+	/*! Определяется c = a b (c может совпадать с a или b). */
+	static void _MultSmall(const _Small a, const _Small b, _Small c)
+	{
+		_Small t;
+		for (size_t i = 0; i < B_PER_W; ++i)
+		{
+			t[i] = 0;
+			for (word w = a[i]; w; w &= w - 1)
+				t[i] ^= b[WordLoBit(w)];
+		}
+		std::copy(t, t + B_PER_W, c);
+	}
+
+	//! Выбор подматрицы
+	/*! Для симметричной матрицы t = V^T B V определяется набор s
+		столбцов, по которым подматрица t обратима, и матрица
+		winv = S (S^T t S)^{-1} S^T. В первую очередь выбираются 
+		столбцы, которые не вошли в набор last размера lastDim 
+		предыдущего шага (Montgomery, 1995). 
+		\return Размер набора s или 0, если выбор невозможен. */
+	static size_t _Select(const _Small t, size_t s[B_PER_W],
+		const size_t last[B_PER_W], size_t lastDim, _Small winv)
+	{
+		// [t | I]
+		word m[B_PER_W][2];
+		for (size_t i = 0; i < B_PER_W; ++i)
+			m[i][0] = t[i], m[i][1] = WORD_1 << i;
+		// столбцы last -- в конец
+		word mask = 0;
+		size_t cols = B_PER_W;
+		for (size_t i = 0; i < lastDim; ++i)
+			s[--cols] = last[i], mask |= WORD_1 << last[i];
+		for (size_t i = 0, j = 0; i < B_PER_W; ++i)
+			if (!(mask >> i & 1))
+				s[j++] = i;
+		size_t dim = 0;
+		for (size_t i = 0; i < B_PER_W; ++i)
+		{
+			// опорная строка в левой половине
+			mask = WORD_1 << s[i];
+			size_t j = i;
+			while (j < B_PER_W && !(m[s[j]][0] & mask))
+				++j;
+			if (j < B_PER_W)
+			{
+				std::swap(m[s[i]][0], m[s[j]][0]);
+				std::swap(m[s[i]][1], m[s[j]][1]);
+				for (j = 0; j < B_PER_W; ++j)
+					if (j != i && (m[s[j]][0] & mask))
+						m[s[j]][0] ^= m[s[i]][0], m[s[j]][1] ^= m[s[i]][1];
+				s[dim++] = s[i];
+				continue;
+			}
+			// опорная строка в правой половине: столбец не выбирается
+			for (j = i; j < B_PER_W && !(m[s[j]][1] & mask); ++j);
+			if (j == B_PER_W)
+				return 0;
+			std::swap(m[s[i]][0], m[s[j]][0]);
+			std::swap(m[s[i]][1], m[s[j]][1]);
+			for (j = 0; j < B_PER_W; ++j)
+				if (j != i && (m[s[j]][1] & mask))
+					m[s[j]][0] ^= m[s[i]][0], m[s[j]][1] ^= m[s[i]][1];
+			m[s[i]][0] = m[s[i]][1] = 0;
+		}
+		for (size_t i = 0; i < B_PER_W; ++i)
+			winv[i] = m[i][1];
+		return dim;
+	}
+
+	//! Векторы ядра
+	/*! Реализация Kernel() с необязательным пулом. */
+	size_t _Kernel(Mat& ker, size_t count, Pool* pool) const
+	{
+		const size_t n = _cols, m = _rows.size();
+		ker.Resize(0, n);
+		if (n == 0 || count == 0)
+			return 0;
+		// симметричный оператор B = A^T A
+		SMat t;
+		Transpose(t);
+		std::vector<word> tmp(m);
+		auto apply = [&](const word* x, word* y)
+		{
+			_MultBlock(x, tmp.data(), pool);
+			t._MultBlock(tmp.data(), y, pool);
+		};
+		Mat found(0, n);
+		std::vector<word> y(n), b(n), x(n), v0(n), v1(n), v2(n), av(n);
+		std::vector<word> ax(m), ux, vec;
+		for (size_t attempt = 0; attempt < 4 && found.Rows() < count;
+			++attempt)
+		{
+			// решение X системы B X = B Y: X + Y лежит в ядре B
+			Env::RandMem(y.data(), n * sizeof(word));
+			apply(y.data(), b.data());
+			v0 = b;
+			std::fill(x.begin(), x.end(), 0);
+			std::fill(v1.begin(), v1.end(), 0);
+			std::fill(v2.begin(), v2.end(), 0);
+			// V_i^T B V_i, (B V_i)^T (B V_i), W_i^{-1} для i, i - 1, i - 2
+			_Small vav[2] = {}, va2v[2] = {}, winv[3] = {};
+			_Small d, e, f, f2, vb;
+			size_t s[2][B_PER_W], dim1 = B_PER_W;
+			for (size_t i = 0; i < B_PER_W; ++i)
+				s[1][i] = i;
+			word mask1 = WORD_MAX;
+			// итерации: около n / (B_PER_W - 0.76)
+			for (size_t iter = 0; iter <= n / (B_PER_W - 1) + 8; ++iter)
+			{
+				apply(v0.data(), av.data());
+				_Inner(v0.data(), av.data(), n, vav[0], pool);
+				_Inner(av.data(), av.data(), n, va2v[0], pool);
+				word nz = 0;
+				for (size_t i = 0; i < B_PER_W; ++i)
+					nz |= vav[0][i];
+				if (nz == 0)
+					break;
+				size_t dim0 = _Select(vav[0], s[0], s[1], dim1, winv[0]);
+				if (dim0 == 0)
+					break;
+				word mask0 = 0;
+				for (size_t i = 0; i < dim0; ++i)
+					mask0 |= WORD_1 << s[0][i];
+				// каждый столбец должен войти в набор s_i или s_{i - 1}
+				if ((mask0 | mask1) != WORD_MAX)
+					break;
+				// X += V_i W_i^{-1} V_i^T V_0
+				_Inner(v0.data(), b.data(), n, vb, pool);
+				_MultSmall(winv[0], vb, vb);
+				_MultSmall(v0.data(), vb, x.data(), n, pool);
+				// V_{i + 1} = B V_i S_i S_i^T + V_i D + V_{i - 1} E +
+				// V_{i - 2} F
+				for (size_t i = 0; i < B_PER_W; ++i)
+					d[i] = (va2v[0][i] & mask0) ^ vav[0][i];
+				_MultSmall(winv[0], d, d);
+				for (size_t i = 0; i < B_PER_W; ++i)
+					d[i] ^= WORD_1 << i;
+				_MultSmall(winv[1], vav[0], e);
+				for (size_t i = 0; i < B_PER_W; ++i)
+					e[i] &= mask0;
+				_MultSmall(vav[1], winv[1], f);
+				for (size_t i = 0; i < B_PER_W; ++i)
+					f[i] ^= WORD_1 << i;
+				_MultSmall(winv[2], f, f);
+				for (size_t i = 0; i < B_PER_W; ++i)
+					f2[i] = ((va2v[1][i] & mask1) ^ vav[1][i]) & mask0;
+				_MultSmall(f, f2, f);
+				for (size_t k = 0; k < n; ++k)
+					av[k] &= mask0;
+				_MultSmall(v0.data(), d, av.data(), n, pool);
+				_MultSmall(v1.data(), e, av.data(), n, pool);
+				_MultSmall(v2.data(), f, av.data(), n, pool);
+				// сдвиг
+				v2.swap(v1), v1.swap(v0), v0.swap(av);
+				std::copy(winv[1], winv[1] + B_PER_W, winv[2]);
+				std::copy(winv[0], winv[0] + B_PER_W, winv[1]);
+				std::copy(vav[0], vav[0] + B_PER_W, vav[1]);
+				std::copy(va2v[0], va2v[0] + B_PER_W, va2v[1]);
+				std::copy(s[0], s[0] + dim0, s[1]);
+				mask1 = mask0, dim1 = dim0;
+			}
+			// векторы X + Y и V_m в основном лежат в ядре B: 
+			// отбираются их комбинации, которые лежат в ядре A
+			for (size_t k = 0; k < n; ++k)
+				x[k] ^= y[k];
+			Mat imgs(m, 2 * B_PER_W), combs;
+			_MultBlock(x.data(), ax.data(), pool);
+			_MultBlock(v0.data(), tmp.data(), pool);
+			for (size_t i = 0; i < m; ++i)
+				imgs.Row(i)[0] = ax[i], imgs.Row(i)[1] = tmp[i];
+			imgs.Kernel(combs);
+			// комбинации вычисляются блоками по B_PER_W
+			Mat more(found.Rows() + combs.Rows(), n);
+			for (size_t i = 0; i < found.Rows(); ++i)
+				std::copy(found.Row(i), found.Row(i) + found.Stride(),
+					more.Row(i));
+			for (size_t first = 0; first < combs.Rows(); first += B_PER_W)
+			{
+				size_t lanes = std::min<size_t>(B_PER_W, combs.Rows() - first);
+				_Small cx = {}, cv = {};
+				for (size_t l = 0; l < lanes; ++l)
+					for (size_t i = 0; i < B_PER_W; ++i)
+					{
+						cx[i] |= word(combs.Get(first + l, i)) << l;
+						cv[i] |= word(combs.Get(first + l, B_PER_W + i)) << l;
+					}
+				ux.assign(n, 0);
+				_MultSmall(x.data(), cx, ux.data(), n, pool);
+				_MultSmall(v0.data(), cv, ux.data(), n, pool);
+				for (size_t l = 0; l < lanes; ++l)
+				{
+					_Lane(ux, l, vec);
+					std::copy(vec.begin(), vec.end(), 
+						more.Row(found.Rows() + first + l));
+				}
+			}
+			size_t rank = more.Echelon(false);
+			found.Resize(rank, n);
+			for (size_t i = 0; i < rank; ++i)
+				std::copy(more.Row(i), more.Row(i) + more.Stride(),
+					found.Row(i));
+		}
+		// не более count векторов
+		ker.Resize(std::min(count, found.Rows()), n);
+		for (size_t i = 0; i < ker.Rows(); ++i)
+			std::copy(found.Row(i), found.Row(i) + found.Stride(), ker.Row(i));
+		return ker.Rows();
+	}
+
+public:
+	//! Число строк
+	size_t Rows() const
+	{
+		return _rows.size();
+	}
+
+	//! Число столбцов
+	size_t Cols() const
+	{
+		return _cols;
+	}
+
+	//! Число ненулевых элементов
+	size_t Weight() const
+	{
+		size_t weight = 0;
+		for (const auto& row : _rows)
+			weight += row.size();
+		return weight;
+	}
+
+	//! Строка
+	/*! Возвращается возрастающий список номеров ненулевых столбцов
+		строки i. При изменении списка должна сохраняться
+		его упорядоченность. */
+	std::vector<size_t>& Row(size_t i)
+	{
+		assert(i < _rows.size());
+		return _rows[i];
+	}
+	const std::vector<size_t>& Row(size_t i) const
+	{
+		assert(i < _rows.size());
+		return _rows[i];
+	}
+
+	//! Элемент
+	bool Get(size_t i, size_t j) const
+	{
+		assert(j < _cols);
+		return std::binary_search(Row(i).begin(), Row(i).end(), j);
+	}
+
+	//! Инверсия элемента
+	void Flip(size_t i, size_t j)
+	{
+		assert(j < _cols);
+		auto pos = std::lower_bound(Row(i).begin(), Row(i).end(), j);
+		if (pos != Row(i).end() && *pos == j)
+			Row(i).erase(pos);
+		else
+			Row(i).insert(pos, j);
+	}
+
+	//! Изменение размеров
+	/*! Матрица заменяется на нулевую матрицу размера rows x cols. */
+	void Resize(size_t rows, size_t cols)
+	{
+		_rows.assign(rows, std::vector<size_t>());
+		_cols = cols;
+	}
+
+	//! Транспонирование
+	void Transpose(SMat& t) const
+	{
+		assert(&t != this);
+		t.Resize(_cols, _rows.size());
+		for (size_t i = 0; i < _rows.size(); ++i)
+			for (size_t j : _rows[i])
+				t._rows[j].push_back(i);
+	}
+
+	//! Построение по системе
+	/*! Строится матрица Маколея системы system: строка i соответствует
+		многочлену с номером i, столбец j -- моному с номером j
+		многочлена mons, который составляется из всех мономов системы.
+		Мономы mons упорядочены по убыванию, поэтому первыми идут
+		столбцы старших мономов. */
+	template<size_t _n, class _O>
+	void From(const MI<_n, _O>& system, MP<_n, _O>& mons)
+	{
+		mons.SetOrder(system.GetOrder());
+		system.GatherMons(mons);
+		std::vector<MM<_n>> index(mons.begin(), mons.end());
+		Resize(system.Size(), index.size());
+		size_t i = 0;
+		for (auto iter = system.begin(); iter != system.end(); ++iter, ++i)
+		{
+			// мономы многочлена упорядочены так же, как index
+			auto pos = index.begin();
+			for (auto m = iter->begin(); m != iter->end(); ++m)
+			{
+				pos = std::lower_bound(pos, index.end(), *m,
+					system.GetOrder());
+				assert(pos != index.end() && *pos == *m);
+				_rows[i].push_back(pos - index.begin());
+			}
+		}
+	}
+
+	//! Преобразование в систему
+	/*! Строка i матрицы преобразуется в многочлен с номером i системы
+		system, столбец j соответствует моному с номером j многочлена mons
+		(см. From()). Нулевые строки дают нулевые многочлены.
+		\pre mons.Size() == Cols(). */
+	template<size_t _n, class _O>
+	void To(MI<_n, _O>& system, const MP<_n, _O>& mons) const
+	{
+		assert(mons.Size() == _cols);
+		std::vector<MM<_n>> index(mons.begin(), mons.end());
+		system.SetEmpty();
+		system.SetOrder(mons.GetOrder());
+		for (size_t i = 0; i < _rows.size(); ++i)
+		{
+			auto pos = system.insert(system.end(), MP<_n, _O>());
+			pos->SetOrder(mons.GetOrder());
+			for (size_t j : _rows[i])
+				pos->push_back(index[j]);
+		}
+	}
+
+	//! Умножение на вектор
+	/*! Определяется y = Ax, где A -- матрица *this, x упакован
+		в ceil(Cols() / B_PER_W) слов, y -- в ceil(Rows() / B_PER_W) слов. */
+	void Mult(const std::vector<word>& x, std::vector<word>& y) const
+	{
+		assert(x.size() * B_PER_W >= _cols);
+		y.assign((_rows.size() + B_PER_W - 1) / B_PER_W, 0);
+		for (size_t i = 0; i < _rows.size(); ++i)
+		{
+			word bit = 0;
+			for (size_t j : _rows[i])
+				bit ^= x[j / B_PER_W] >> j % B_PER_W;
+			y[i / B_PER_W] |= (bit & 1) << i % B_PER_W;
+		}
+	}
+
+	//! Умножение на блок векторов
+	/*! Определяется Y = AX, где A -- матрица *this, X -- блок из B_PER_W
+		векторов длины Cols(), Y -- блок векторов длины Rows(). Слово x[j]
+		содержит j-е символы векторов блока X (по одному в каждом бите),
+		слово y[i] -- i-е символы векторов блока Y. */
+	void MultBlock(const std::vector<word>& x, std::vector<word>& y) const
+	{
+		assert(x.size() >= _cols);
+		y.resize(_rows.size());
+		_MultBlock(x.data(), y.data(), 0);
+	}
+
+	//! Умножение на блок векторов (параллельно)
+	/*! Группы строк обрабатываются на исполнителях пула pool. */
+	void MultBlock(Pool& pool, const std::vector<word>& x,
+		std::vector<word>& y) const
+	{
+		assert(x.size() >= _cols);
+		y.resize(_rows.size());
+		_MultBlock(x.data(), y.data(), &pool);
+	}
+
+	//! Ранг
+	size_t Rank() const
+	{
+		std::vector<std::vector<size_t>> rows(_rows);
+		_Elim e;
+		_Eliminate(rows, _cols, false, e, 0);
+		return e.cols.size() + e.rank;
+	}
+
+	//! Решение системы
+	/*! Находится решение x системы Ax = b, где A -- матрица *this.
+		Векторы b и x упакованы так же, как в Mult(). Свободные
+		переменные решения нулевые.
+		\return Признак совместности системы. */
+	bool Solve(const std::vector<word>& b, std::vector<word>& x) const
+	{
+		assert(b.size() * B_PER_W >= _rows.size());
+		// правая часть -- фиктивный столбец _cols
+		std::vector<std::vector<size_t>> rows(_rows);
+		for (size_t i = 0; i < rows.size(); ++i)
+			if (b[i / B_PER_W] >> i % B_PER_W & 1)
+				rows[i].push_back(_cols);
+		_Elim e;
+		_Eliminate(rows, _cols, true, e, 0);
+		// переменные плотной подматрицы
+		x.assign((_cols + B_PER_W - 1) / B_PER_W, 0);
+		const size_t dc = e.dcols.size();
+		for (size_t i = 0; i < e.rank; ++i)
+		{
+			size_t j = e.dense.Lead(i);
+			if (j == dc)
+				return false;
+			if (e.dense.Get(i, dc))
+				x[e.dcols[j] / B_PER_W] |= WORD_1 << e.dcols[j] % B_PER_W;
+		}
+		// опорные переменные в обратном порядке
+		for (size_t l = e.cols.size(); l--;)
+		{
+			word bit = 0;
+			for (size_t j : e.rows[l])
+				if (j == _cols)
+					bit ^= 1;
+				else if (j != e.cols[l])
+					bit ^= x[j / B_PER_W] >> j % B_PER_W;
+			x[e.cols[l] / B_PER_W] |= (bit & 1) << e.cols[l] % B_PER_W;
+		}
+		return true;
+	}
+
+	//! Младшая часть пространства строк
+	/*! Определяется базис пространства векторов из линейной оболочки
+		строк, ненулевые элементы которых стоят только в столбцах
+		first, first + 1,..., Cols() - 1. Если матрица построена
+		по системе (см. From()), то это многочлены идеала системы,
+		составленные из младших мономов. Векторы базиса возвращаются
+		как строки матрицы tail размера dim x Cols() в приведенном
+		ступенчатом виде.
+		\return Размерность dim. */
+	size_t Tail(size_t first, SMat& tail, Pool* pool = 0) const
+	{
+		assert(&tail != this);
+		std::vector<std::vector<size_t>> rows(_rows);
+		_Elim e;
+		_Eliminate(rows, std::min(first, _cols), false, e, pool);
+		// строки плотной подматрицы, которые начинаются не раньше first
+		tail.Resize(0, _cols);
+		for (size_t i = 0; i < e.rank; ++i)
+		{
+			if (e.dcols[e.dense.Lead(i)] < first)
+				continue;
+			tail._rows.emplace_back();
+			const word* row = e.dense.Row(i);
+			for (size_t pos = 0; pos < e.dense.Stride(); ++pos)
+				for (word w = row[pos]; w; w &= w - 1)
+					tail._rows.back().push_back(
+						e.dcols[pos * B_PER_W + WordLoBit(w)]);
+		}
+		return tail.Rows();
+	}
+
+	//! Векторы ядра
+	/*! Блочным методом Ланцоша определяется до count линейно 
+		независимых векторов пространства решений системы Ax = 0, где 
+		A -- матрица *this. Векторы возвращаются как строки матрицы ker
+		размера dim x Cols(). Метод применяется к матрице A^T A, 
+		и найденные векторы комбинируются так, чтобы попасть в ядро A:
+		за один проход находится не более 2 B_PER_W векторов. Метод
+		вероятностный: dim может оказаться меньше min(count, 
+		Cols() - rank) (при повторном вызове будут выбраны другие
+		случайные векторы).
+		\return Число векторов dim. */
+	size_t Kernel(Mat& ker, size_t count = 1) const
+	{
+		return _Kernel(ker, count, 0);
+	}
+
+	//! Векторы ядра (параллельно)
+	/*! Умножения на блоки векторов выполняются на исполнителях
+		пула pool. */
+	size_t Kernel(Pool& pool, Mat& ker, size_t count = 1) const
+	{
+		return _Kernel(ker, count, &pool);
+	}
+
+// конструкторы
+public:
+	//! Конструктор
+	/*! Создается нулевая матрица размера rows x cols. */
+	SMat(size_t rows = 0, size_t cols = 0)
+	{
+		Resize(rows, cols);
+	}
+};
+
+} // namespace GF2
+
+#endif // __GF2_SMAT
@@ -4,7 +4,7 @@
 \brief Binary words of arbitrary length
 \project GF2 [algebra over GF(2)]
 \created 2004.01.01
-\version 2020.05.27
+\version 2026.10.16
 \license This program is released under the MIT License. See Copyright Notices 
 in GF2/info.h.
 *******************************************************************************
@@ -30,6 +30,25 @@ in GF2/info.h.
 
 namespace GF2 {
 
+//! Младший ненулевой бит
+/*! Определяется номер младшего ненулевого бита машинного слова w.
+	\pre w != 0. */
+inline size_t WordLoBit(word w)
+{
+	assert(w != 0);
+#if defined(__GNUC__) || defined(__clang__)
+	if constexpr (B_PER_W == 64)
+		return size_t(__builtin_ctzll((unsigned long long)w));
+	else
+		return size_t(__builtin_ctz((unsigned)w));
+#else
+	size_t pos = 0;
+	for (; (w & 255) == 0; w >>= 8, pos += 8);
+	for (; (w & 1) == 0; w >>= 1, ++pos);
+	return pos;
+#endif
+}
+
 /*!
 *******************************************************************************
 Класс WW
@@ -405,23 +424,20 @@ public:
 	}
 
 	//! Вес
-	/*! Определяется вес (число ненулевых символов) слова. */
+	/*! Определяется вес (число ненулевых символов) слова. 
+		\remark Веса машинных слов определяются параллельным суммированием 
+		битов (SWAR). */
 	size_t Weight() const
 	{	
-		static unsigned char _bitsperoctet[256] = 
-		{
-			0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,1,2,2,3,2,3,3,4,2,3,3,4,3,4,4,5,
-			1,2,2,3,2,3,3,4,2,3,3,4,3,4,4,5,2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,
-			1,2,2,3,2,3,3,4,2,3,3,4,3,4,4,5,2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,
-			2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,3,4,4,5,4,5,5,6,4,5,5,6,5,6,6,7,
-			1,2,2,3,2,3,3,4,2,3,3,4,3,4,4,5,2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,
-			2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,3,4,4,5,4,5,5,6,4,5,5,6,5,6,6,7,
-			2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,3,4,4,5,4,5,5,6,4,5,5,6,5,6,6,7,
-			3,4,4,5,4,5,5,6,4,5,5,6,5,6,6,7,4,5,5,6,5,6,6,7,5,6,6,7,6,7,7,8,
-		};
 		size_t weight = 0;
-		for (size_t pos = 0; pos < _ocount; pos++)
-			weight += _bitsperoctet[GetOctet(pos)];
+		for (size_t pos = 0; pos < _wcount; pos++)
+		{
+			word w = _words[pos];
+			w -= (w >> 1) & (WORD_MAX / 3);
+			w = (w & (WORD_MAX / 5)) + ((w >> 2) & (WORD_MAX / 5));
+			w = (w + (w >> 4)) & (WORD_MAX / 17);
+			weight += size_t(word(w * (WORD_MAX / 255)) >> (B_PER_W - 8));
+		}
 		return weight;
 	}
 
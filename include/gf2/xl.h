@@ -0,0 +1,323 @@
+/*
+*******************************************************************************
+\file xl.h
+\brief XL algorithm
+\project GF2 [algebra over GF(2)]
+\created 2026.10.16
+\version 2026.10.16
+\license This program is released under the MIT License. See Copyright Notices
+in GF2/info.h.
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file xl.h
+\brief Алгоритм XL
+
+Модуль содержит описание и реализацию класса XL, который решает системы
+уравнений линеаризацией (алгоритмы XL и MutantXL).
+*******************************************************************************
+*/
+
+#ifndef __GF2_XL
+#define __GF2_XL
+
+#include "gf2/mi.h"
+#include "gf2/pool.h"
+#include "gf2/smat.h"
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace GF2 {
+
+/*!
+*******************************************************************************
+Класс XL
+
+Решение системы уравнений {p = 0: p in system} линеаризацией (алгоритм XL,
+Courtois et al., 2000). Многочлены системы умножаются на все мономы
+от существенных переменных системы так, чтобы степени произведений
+не превосходили D. Произведения -- строки разреженной матрицы SMat,
+мономы -- ее столбцы. Столбцы упорядочены сначала по убыванию степеней
+мономов, а затем по убыванию в мономиальном порядке системы. Поэтому
+после исключения младшая часть пространства строк (см. SMat::Tail())
+составлена из многочленов степени меньше D, а среди них -- из линейных.
+
+Произведения не хранятся как многочлены: номера столбцов строки
+вычисляются сразу по мономам произведения с помощью словаря мономов,
+совпадающие номера взаимно уничтожаются.
+
+Найденные многочлены степени меньше D (мутанты, Ding et al., 2008)
+умножаются на переменные, произведения добавляются к матрице, и она
+приводится заново при той же степени D, пока пространство мутантов
+растет. Затем степень D увеличивается.
+Вычисления завершаются, когда найдены линейные многочлены, которые
+определяют все переменные (система имеет единственное решение), или
+найдена 1 (система несовместна), или степень D превысила ограничение.
+
+\code
+	XL<n, O> xl;
+	MI<n, O> lin;
+	if (xl.Process(system, lin))
+		...
+\endcode
+*******************************************************************************
+*/
+
+template<size_t _n, class _O> class XL
+{
+protected:
+	typedef MI<_n, _O> _I;
+	typedef MP<_n, _O> _P;
+
+	//! Хэш монома
+	struct _MonHash
+	{
+		size_t operator()(const MM<_n>& mon) const
+		{
+			size_t h = 0;
+			for (size_t pos = 0; pos < mon.WordSize(); ++pos)
+				h = (h ^ size_t(mon.GetWord(pos))) *
+					size_t(0x9E3779B97F4A7C15ull) + (h >> 29);
+			return h;
+		}
+	};
+
+	Pool* _pool; // пул потоков
+	size_t _maxDeg; // наибольшая степень D
+	bool _mutants; // признак использования мутантов
+	size_t _deg; // достигнутая степень D
+	size_t _rows; // число строк последней матрицы
+	size_t _cols; // число столбцов последней матрицы
+
+	//! Мономы-множители
+	/*! Определяются все мономы от переменных vars степени не выше deg,
+		упорядоченные по возрастанию степеней. */
+	static void _Mults(const std::vector<size_t>& vars, size_t deg,
+		std::vector<MM<_n>>& mults)
+	{
+		mults.assign(1, MM<_n>());
+		// мономы степени d + 1 -- произведения мономов степени d
+		// на переменные, старшие их переменных
+		std::vector<size_t> last(1, 0);
+		for (size_t d = 0, first = 0; d < deg; ++d)
+		{
+			size_t end = mults.size();
+			for (size_t i = first; i < end; ++i)
+				for (size_t v = last[i]; v < vars.size(); ++v)
+				{
+					mults.push_back(mults[i]);
+					mults.back().Set(vars[v], 1);
+					last.push_back(v + 1);
+				}
+			first = end;
+		}
+	}
+
+	//! Исключение
+	/*! Строится матрица произведений многочленов system на мономы
+		от переменных vars степени не выше deg и мутантов mutants
+		на переменные vars. Определяются многочлены пространства строк
+		степени меньше deg (в low).
+		\return Признак наличия 1 в low. */
+	bool _Step(const _I& system, const _I& mutants,
+		const std::vector<size_t>& vars, size_t deg, _I& low)
+	{
+		// множители
+		std::vector<MM<_n>> mults;
+		_Mults(vars, deg - std::max(system.MinDeg(), 0), mults);
+		// строки: номера мономов в словаре
+		std::unordered_map<MM<_n>, size_t, _MonHash> index;
+		std::vector<MM<_n>> mons;
+		std::vector<std::vector<size_t>> rows;
+		std::vector<size_t> row;
+		MM<_n> mon;
+		auto add = [&](const _P& poly, size_t maxDeg)
+		{
+			for (auto m = mults.begin();
+				m != mults.end() && size_t(m->Deg()) <= maxDeg; ++m)
+			{
+				row.clear();
+				for (auto t = poly.begin(); t != poly.end(); ++t)
+				{
+					mon = *t, mon *= *m;
+					auto pos = index.emplace(mon, mons.size());
+					if (pos.second)
+						mons.push_back(mon);
+					row.push_back(pos.first->second);
+				}
+				// совпадающие мономы уничтожаются
+				std::sort(row.begin(), row.end());
+				size_t size = 0;
+				for (size_t i = 0; i < row.size(); ++i)
+					if (i + 1 < row.size() && row[i] == row[i + 1])
+						++i;
+					else
+						row[size++] = row[i];
+				row.resize(size);
+				if (!row.empty())
+					rows.push_back(row);
+			}
+		};
+		for (auto iter = system.begin(); iter != system.end(); ++iter)
+			add(*iter, deg - std::max(iter->Deg(), 0));
+		for (auto iter = mutants.begin(); iter != mutants.end(); ++iter)
+			add(*iter, 1);
+		// столбцы: по убыванию степеней, затем в порядке системы
+		const _O& order = system.GetOrder();
+		std::vector<size_t> perm(mons.size()), col(mons.size());
+		for (size_t i = 0; i < perm.size(); ++i)
+			perm[i] = i;
+		std::sort(perm.begin(), perm.end(), [&](size_t i, size_t j)
+		{
+			int d1 = mons[i].Deg(), d2 = mons[j].Deg();
+			return d1 != d2 ? d1 > d2 : order(mons[i], mons[j]);
+		});
+		size_t first = 0;
+		for (size_t c = 0; c < perm.size(); ++c)
+		{
+			col[perm[c]] = c;
+			if (size_t(mons[perm[c]].Deg()) >= deg)
+				first = c + 1;
+		}
+		SMat a(rows.size(), mons.size()), tail;
+		for (size_t i = 0; i < rows.size(); ++i)
+		{
+			for (auto& j : rows[i])
+				j = col[j];
+			std::sort(rows[i].begin(), rows[i].end());
+			a.Row(i).swap(rows[i]);
+		}
+		_rows = a.Rows(), _cols = a.Cols();
+		a.Tail(first, tail, _pool);
+		// младшие многочлены
+		low.SetEmpty();
+		low.SetOrder(order);
+		bool one = false;
+		for (size_t i = 0; i < tail.Rows(); ++i)
+		{
+			_P poly(order);
+			for (size_t j : tail.Row(i))
+				poly.push_back(mons[perm[j]]);
+			poly.Normalize();
+			one = one || poly == 1;
+			low.insert(low.end(), _P(order))->Swap(poly);
+		}
+		return one;
+	}
+
+public:
+	//! Решение
+	/*! Решается система system. Найденные линейные многочлены идеала
+		системы в приведенном ступенчатом виде возвращаются в lin.
+		Если система несовместна, то lin = {1}.
+		\return Признак того, что система решена: несовместна или
+		lin определяет значения всех существенных переменных. */
+	bool Process(const _I& system, _I& lin)
+	{
+		lin.SetEmpty();
+		lin.SetOrder(system.GetOrder());
+		_deg = 0, _rows = _cols = 0;
+		// существенные переменные
+		std::vector<size_t> vars;
+		MM<_n> mon = system.GatherVars();
+		for (size_t pos = 0; pos < _n; ++pos)
+			if (mon.Test(pos))
+				vars.push_back(pos);
+		// тривиальные системы
+		for (auto iter = system.begin(); iter != system.end(); ++iter)
+			if (*iter == 1)
+			{
+				lin.insert(lin.end(), _P(*iter));
+				return true;
+			}
+		if (system.IsEmpty())
+			return vars.empty();
+		// степени D
+		_I mutants, low;
+		size_t maxDeg = std::min(_maxDeg, std::max(vars.size(), size_t(1)));
+		for (_deg = std::max(system.MaxDeg(), 1); _deg <= maxDeg; )
+		{
+			size_t prev = low.Size();
+			bool one = _Step(system, mutants, vars, _deg, low);
+			lin.SetEmpty();
+			for (auto iter = low.begin(); iter != low.end(); ++iter)
+				if (iter->Deg() <= 1)
+					lin.insert(lin.end(), *iter);
+			if (one)
+			{
+				lin.SetEmpty();
+				lin.insert(lin.end(), _P(true));
+				lin.front().SetOrder(system.GetOrder());
+				return true;
+			}
+			if (lin.Size() == vars.size())
+				return true;
+			// мутанты
+			if (_mutants && low.Size() > prev)
+			{
+				mutants = low;
+				continue;
+			}
+			++_deg, low.SetEmpty();
+		}
+		_deg = maxDeg;
+		return false;
+	}
+
+	//! Пул потоков
+	/*! Устанавливается пул потоков pool, на исполнителях которого
+		приводится плотная часть матрицы. При pool == 0 (по умолчанию)
+		приведение последовательное. */
+	void SetPool(Pool* pool)
+	{
+		_pool = pool;
+	}
+
+	//! Ограничение степени
+	/*! Устанавливается наибольшая степень D. По умолчанию степень
+		ограничена только числом существенных переменных системы. */
+	void SetMaxDeg(size_t deg)
+	{
+		_maxDeg = deg;
+	}
+
+	//! Использование мутантов
+	/*! При mutants == true (по умолчанию) используются мутанты
+		(алгоритм MutantXL), иначе степень D увеличивается сразу
+		(алгоритм XL). */
+	void SetMutants(bool mutants)
+	{
+		_mutants = mutants;
+	}
+
+	//! Достигнутая степень D
+	size_t GetDeg() const
+	{
+		return _deg;
+	}
+
+	//! Число строк последней матрицы
+	size_t GetRows() const
+	{
+		return _rows;
+	}
+
+	//! Число столбцов последней матрицы
+	size_t GetCols() const
+	{
+		return _cols;
+	}
+
+	//! Конструктор
+	XL() : _pool(0), _maxDeg(SIZE_MAX), _mutants(true), _deg(0), _rows(0),
+		_cols(0)
+	{
+	}
+};
+
+} // namespace GF2
+
+#endif // __GF2_XL
@@ -4,7 +4,7 @@
 \brief Binary words as integers
 \project GF2 [algebra over GF(2)]
 \created 2004.01.01
-\version 2020.07.14
+\version 2026.10.16
 \license This program is released under the MIT License. See Copyright Notices 
 in GF2/info.h.
 *******************************************************************************
@@ -483,7 +483,8 @@ public:
 	template<size_t _m> 
 	ZZ& operator/=(const ZZ<_m>& zRight)
 	{	
-		return Div(ZZ<_m>(zRight));
+		ZZ<_m> mod(zRight);
+		return Div(mod);
 	}
 
 	//! Остаток
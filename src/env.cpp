@@ -4,7 +4,7 @@
 \brief The runtime environment
 \project GF2 [algebra over GF(2)]
 \created 2004.01.01
-\version 2020.04.22
+\version 2026.10.16
 \license This program is released under the MIT License. See Copyright Notices
 in GF2/info.h.
 *******************************************************************************
@@ -32,6 +32,8 @@ using namespace GF2;
 #include <stdio.h>
 #include <string.h>
 #include <wchar.h>
+#include <atomic>
+#include <mutex>
 #if defined OS_WIN
 	#include <windows.h>
 #elif defined OS_LINUX
@@ -121,11 +123,19 @@ void Env::Print(const wchar_t* format,...)
 	va_end(args);
 }
 
+static std::atomic<bool> _trace(true); //< признак отладочной печати
+static std::mutex _traceLock; //< блокировка отладочной печати
+
 // Отладочная печать
 void Env::Trace(const char* format,...)
 {	
 	static char prevbuf[1024];
 	static char buf[1024];
+	// печать выключена?
+	if (!_trace)
+		return;
+	// печать из нескольких потоков
+	std::lock_guard<std::mutex> guard(_traceLock);
 	// пустая форматная строка?
 	if (::strlen(format) == 0)
 	{
@@ -166,6 +176,12 @@ void Env::Trace(const char* format,...)
 	}
 }
 
+// Включить / выключить отладочную печать
+void Env::SetTrace(bool on)
+{
+	_trace = on;
+}
+
 // Время (в ms) с отправного момента в прошлом
 u32 Env::Ticks()
 {
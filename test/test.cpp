@@ -4,15 +4,28 @@
 \brief Tests
 \project GF2 [algebra over GF(2)]
 \created 2016.07.06
-\version 2020.07.15
+\version 2026.10.16
 \license This program is released under the MIT License. See Copyright Notices 
 in GF2/info.h.
 *******************************************************************************
 */
 
+#include "gf2/batch.h"
 #include "gf2/buchb.h"
+#include "gf2/buchbsig.h"
+#include "gf2/elimlin.h"
+#include "gf2/eval.h"
+#include "gf2/exhaust.h"
+#include "gf2/fglm.h"
 #include "gf2/func.h"
+#include "gf2/hybrid.h"
+#include "gf2/io.h"
+#include "gf2/mat.h"
 #include "gf2/mi.h"
+#include "gf2/mt.h"
+#include "gf2/smat.h"
+#include "gf2/xl.h"
+#include <cstdio>
 #include <sstream>
 
 using namespace GF2;
@@ -30,6 +43,7 @@ using namespace std;
 template class GF2::WW<127>;
 	template class GF2::MM<129>;
 	template class GF2::ZZ<130>;
+template class GF2::MMTree<131>;
 
 template struct GF2::MOGr<MOLR<MOLex<65>, MOGrlex<66>>>;
 template struct GF2::MORL<MORev<MOGrevlex<68>>, MOLex<67>>;
@@ -37,6 +51,17 @@ template struct GF2::MORL<MORev<MOGrevlex<68>>, MOLex<67>>;
 template class GF2::MP<135, MOLex<135>>;
 template class GF2::MI<136, MOGrevlex<136>>;
 template class GF2::Buchb<137, MOGrlex<137>>;
+template class GF2::BuchbSig<138, MOGrevlex<138>>;
+template class GF2::BuchbBatch<139, MOGrevlex<139>>;
+template class GF2::Exhaust<140, MOGrevlex<140>>;
+template class GF2::Eval<141>;
+template class GF2::XL<142, MOGrevlex<142>>;
+template class GF2::ElimLin<143, MOGrlex<143>>;
+template class GF2::Hybrid<144, MOGrevlex<144>>;
+template class GF2::FGLM<145, MOGrevlex<145>>;
+template class GF2::MT<146>;
+template class GF2::MTRank<147, MOGrlex<147>>;
+template class GF2::MTP<148, MOLex<148>>;
 
 template class GF2::Func<5, int>;
 	template class GF2::BFunc<6>;
@@ -140,6 +165,62 @@ bool testMP()
 	return true;
 }
 
+/*
+*******************************************************************************
+Тест testMMTree
+
+Дерево делителей: вставки и удаления мономов, поиск делителей и кратных
+(результаты сравниваются с полным перебором).
+*******************************************************************************
+*/
+
+bool testMMTree()
+{
+	const size_t n = 70;
+	MMTree<n> tree;
+	std::vector<MM<n>> mons(600);
+	std::vector<bool> used(mons.size(), false);
+	std::vector<size_t> found, expected;
+	for (size_t t = 0; t < 4000; ++t)
+	{
+		size_t pos = Env::Rand() % mons.size();
+		if (used[pos])
+			tree.Erase(pos, mons[pos]), used[pos] = false;
+		else
+		{
+			// мономы от небольшого числа переменных (много совпадений)
+			mons[pos].SetAll(0);
+			for (size_t k = Env::Rand() % 5; k--;)
+				mons[pos][Env::Rand() % 12 * 6] = 1;
+			tree.Insert(pos, mons[pos]), used[pos] = true;
+		}
+		if (t % 10)
+			continue;
+		MM<n> m;
+		for (size_t k = Env::Rand() % 5; k--;)
+			m[Env::Rand() % 12 * 6] = 1;
+		tree.Multiples(m, found);
+		expected.clear();
+		for (size_t i = 0; i < mons.size(); ++i)
+			if (used[i] && (m | mons[i]))
+				expected.push_back(i);
+		if (found != expected)
+			return false;
+		tree.Divisors(m, found);
+		expected.clear();
+		for (size_t i = 0; i < mons.size(); ++i)
+			if (used[i] && (mons[i] | m))
+				expected.push_back(i);
+		if (found != expected)
+			return false;
+	}
+	for (size_t i = 0; i < mons.size(); ++i)
+		if (tree.IsUsed(i) != used[i])
+			return false;
+	tree.Clear();
+	return tree.Size() == 0 && !tree.IsUsed(0);
+}
+
 /*
 *******************************************************************************
 Тест testОrder
@@ -401,17 +482,15 @@ bool testBash2()
 
 /*
 *******************************************************************************
-Тест testCommute
+Система testCommute
 
-Алгебраическое описание пар коммутируемых обратимым двоичных матриц порядка 2, 
-контроль числа пар.
+Алгебраическое описание пар коммутируемых обратимых двоичных матриц
+порядка 2 (используется в нескольких тестах).
 *******************************************************************************
 */
 
-bool testCommute()
+MI<8, MOGrevlex<8>> CommuteSystem()
 {
-	typedef MOGrevlex<8> O;
-	// система
 	stringstream ss;
 	ss << 
 		"{ x0 x3 + x1 x2 + 1,"				/* обратимость первой матрицы */
@@ -419,8 +498,24 @@ bool testCommute()
 		"  x1 x7 + x3 x5 + x0 x5 + x1 x4,"	/* коммутируемость */
 		"  x2 x7 + x3 x6 + x0 x6 + x2 x4,"	/* коммутируемость */
 		"  x4 x7 + x5 x6 + 1}";				/* обратимость второй матрицы */
-	MI<8, O> i;
+	MI<8, MOGrevlex<8>> i;
 	ss >> i;
+	return i;
+}
+
+/*
+*******************************************************************************
+Тест testCommute
+
+Алгебраическое описание пар коммутируемых обратимым двоичных матриц порядка 2, 
+контроль числа пар.
+*******************************************************************************
+*/
+
+bool testCommute()
+{
+	typedef MOGrevlex<8> O;
+	MI<8, O> i(CommuteSystem());
 	// базис Гребнера
 	Buchb<8, O> bb;
 	bb.Init();
@@ -534,6 +629,1426 @@ bool testEM()
 	return key == (word)0x009D;
 }
 
+/*
+*******************************************************************************
+Тест testCheckpoint
+
+Вычисление базиса Гребнера системы из testCommute() с автоматическими 
+снимками, продолжение вычислений с последнего снимка, сравнение результатов.
+*******************************************************************************
+*/
+
+bool testCheckpoint()
+{
+	typedef MOGrevlex<8> O;
+	const char* path = "testgf2.chk";
+	// система
+	MI<8, O> i(CommuteSystem()), gb1, gb2;
+	// вычисления без перерыва (со снимками)
+	Buchb<8, O> bb1;
+	bb1.Init();
+	bb1.SetCheckpoint(path, 40);
+	bb1.Update(i);
+	bb1.Process();
+	bb1.Done(gb1);
+	// продолжение с последнего снимка
+	Buchb<8, O> bb2;
+	if (!bb2.LoadCheckpoint(path) || bb2.PairsLeft() == 0)
+		return false;
+	bb2.Process();
+	bb2.Done(gb2);
+	std::remove(path);
+	// ошибочный снимок
+	if (bb2.LoadCheckpoint(path))
+		return false;
+	// сравнение
+	return gb1 == gb2 && gb2.IsGB() && gb2.QuotientBasisDim() == word(18);
+}
+
+/*
+*******************************************************************************
+Тест testCPSel
+
+Вычисление базиса Гребнера системы из testCommute() при различных 
+стратегиях выбора критических пар, сравнение результатов. Проверка 
+очереди критических пар (в том числе выбора пар наименьшей степени) 
+и истории обработанных пар.
+*******************************************************************************
+*/
+
+bool testCPSel()
+{
+	typedef MOGrevlex<8> O;
+	// очередь
+	CPQueue<int> q;
+	q.Push(3, 2), q.Push(1, 2), q.Push(2, 1), q.Push(0, 3), q.Push(4, 1);
+	size_t slot = q.Push(5, 1);
+	if (q.Pop() != 2 || q.Pop() != 4 || q.TopKey() != 1 || q.At(slot) != 5)
+		return false;
+	q.Remove(slot);
+	if (q.TopKey() != 2 || q.Size() != 3 || q.Pop() != 1 || q.Pop() != 3 ||
+		q.Pop() != 0 || !q.IsEmpty())
+		return false;
+	// пары наименьшей степени НОК (при любых ключах)
+	struct CP
+	{
+		MM<8> lcm;
+		int id;
+		bool operator<(const CP& cp) const { return id < cp.id; }
+	};
+	CPQueue<CP> q1;
+	q1.Push(CP{MM<8>(0, 1), 5}, 0), q1.Push(CP{MM<8>(1, 2, 3), 2}, 0);
+	q1.Push(CP{MM<8>(4, 5), 3}, 7), q1.Push(CP{MM<8>(2), 4}, 9);
+	q1.Push(CP{MM<8>(6, 7), 1}, 0), q1.Push(CP{MM<8>(3), 6}, 1);
+	std::vector<CP> cps;
+	if (q1.PopMinDeg(cps) != 2 || cps[0].id != 6 || cps[1].id != 4 ||
+		q1.PopMinDeg(cps) != 3 || cps[2].id != 1 || cps[3].id != 5 ||
+		cps[4].id != 3 || q1.Size() != 1 || q1.Pop().id != 2 ||
+		q1.PopMinDeg(cps) != 0)
+		return false;
+	// система
+	MI<8, O> i(CommuteSystem()), gb[3];
+	// стратегии
+	CPSel sel[3] = {CP_SEL_NORMAL, CP_SEL_SUGAR, CP_SEL_DEG};
+	for (size_t t = 0; t < 3; ++t)
+	{
+		Buchb<8, O> bb;
+		bb.Init();
+		bb.SetSelection(sel[t]);
+		bb.SetHistory(5 * t);
+		bb.Update(i);
+		bb.Process();
+		bb.Done(gb[t]);
+		if (!gb[t].IsGB() || gb[t].QuotientBasisDim() != word(18) ||
+			bb.GetHistory().size() != 5 * t)
+			return false;
+	}
+	return gb[0] == gb[1] && gb[1] == gb[2];
+}
+
+/*
+*******************************************************************************
+Случайные системы
+
+Система s дополняется count случайными многочленами степени не выше deg.
+Каждый многочлен -- сумма terms случайных мономов. Многочлены обращаются
+в 0 в точке x0, кроме первых miss многочленов, которые обращаются в 1.
+*******************************************************************************
+*/
+
+template<size_t _n, class _O>
+void RandSystem(MI<_n, _O>& s, const WW<_n>& x0, size_t count, size_t terms,
+	size_t deg = 2, size_t miss = 0)
+{
+	for (size_t e = 0; e < count; ++e)
+	{
+		MP<_n, _O> poly(s.GetOrder());
+		for (size_t j = 0; j < terms; ++j)
+		{
+			MM<_n> m;
+			for (size_t d = 0; d < deg; ++d)
+				m.Set(Env::Rand() % _n, 1);
+			poly += m;
+		}
+		if (poly.Calc(x0) != (e < miss))
+			poly += 1;
+		if (poly != 0)
+			s.Insert(poly);
+	}
+}
+
+/*
+*******************************************************************************
+Тест testBuchbSig
+
+Сигнатурный алгоритм на системе testCommute и на случайных квадратичных
+системах. Базис строится сразу и по частям (с досылкой многочленов после
+Process()) и сравнивается с результатом Buchb.
+*******************************************************************************
+*/
+
+bool testBuchbSig()
+{
+	typedef MOGrevlex<8> O;
+	MI<8, O> i(CommuteSystem()), gb, gb1;
+	// Buchb
+	Buchb<8, O> bb;
+	bb.Init();
+	bb.Update(i);
+	bb.Process();
+	bb.Done(gb);
+	// BuchbSig
+	BuchbSig<8, O> bs;
+	bs.Init();
+	bs.Update(i);
+	bs.Process();
+	bs.Done(gb1);
+	if (gb1 != gb || bs.AvoidedReductions() == 0)
+		return false;
+	// по частям
+	bs.Init();
+	auto iter = i.begin();
+	bs.Update(*iter++), bs.Update(*iter++);
+	bs.Process();
+	for (; iter != i.end(); ++iter)
+		bs.Update(*iter), bs.Process();
+	bs.Done(gb1);
+	if (gb1 != gb || !gb1.IsGB() || gb1.QuotientBasisDim() != word(18))
+		return false;
+	// случайные системы (несовместная при t == 9)
+	const size_t n = 10;
+	Buchb<n, MOGrevlex<n>> bb2;
+	BuchbSig<n, MOGrevlex<n>> bs2;
+	for (size_t t = 0; t < 10; ++t)
+	{
+		MI<n, MOGrevlex<n>> s, gb2, gb3;
+		WW<n> x0;
+		x0.Rand();
+		RandSystem(s, x0, 3 + t, 6, 2, t == 9);
+		bb2.Init(), bb2.Update(s), bb2.Process(), bb2.Done(gb2);
+		bs2.Init(), bs2.Update(s), bs2.Process(), bs2.Done(gb3);
+		if (gb3 != gb2 || !gb3.IsGB())
+			return false;
+	}
+	return true;
+}
+
+/*
+*******************************************************************************
+Тест testBatch
+
+Пакетное построение базисов Гребнера систем, которые описывают S-блоки
+ГОСТ 28147-89 (в нескольких вариантах). Результаты сравниваются
+с последовательными вычислениями.
+*******************************************************************************
+*/
+
+bool testBatch()
+{
+	typedef MOGrevlex<8> O;
+	static const word s_table[4][16] =
+	{
+		{2, 6, 3, 14, 12, 15, 7, 5, 11, 13, 8, 9, 10, 0, 4, 1}, 
+		{8, 12, 9, 6, 10, 7, 13, 1, 3, 11, 14, 15, 2, 4, 0, 5}, 
+		{1, 5, 4, 13, 3, 8, 0, 14, 12, 6, 7, 2, 9, 15, 11, 10}, 
+		{4, 0, 5, 10, 2, 11, 1, 9, 15, 3, 6, 7, 14, 12, 8, 13}, 
+	};
+	// системы и последовательные вычисления
+	std::vector<MI<8, O>> systems(40), gbs(40);
+	for (size_t i = 0; i < systems.size(); ++i)
+	{
+		VSubst<4> s(s_table[i % 4]);
+		// сдвиг в add-семействе
+		for (size_t a = i / 4; a--;)
+		{
+			word t = s[0], x;
+			for (x = 0; x < 15; ++x)
+				s[x] = s[x + 1];
+			s[x] = t;
+		}
+		s.To(systems[i]);
+		Buchb<8, O> bb;
+		bb.Init();
+		bb.Update(systems[i]);
+		bb.Process();
+		bb.Done(gbs[i]);
+	}
+	// пакет
+	Pool pool(4);
+	BuchbBatch<8, O> batch(pool);
+	size_t next = 0;
+	bool ok = true;
+	batch.Process(systems, [&](size_t index, MI<8, O>& gb)
+	{
+		ok = ok && index == next++ && gb == gbs[index];
+	});
+	if (!ok || next != systems.size())
+		return false;
+	std::vector<bool> seen(systems.size(), false);
+	batch.Process(systems, [&](size_t index, MI<8, O>& gb)
+	{
+		ok = ok && !seen[index] && gb == gbs[index];
+		seen[index] = true, ++next;
+	}, false);
+	if (!ok || next != 2 * systems.size())
+		return false;
+	// повторный пакет (рабочие системы берутся из запаса)
+	next = 0;
+	batch.Process(systems.data(), systems.size() / 2,
+		[&](size_t index, MI<8, O>& gb)
+	{
+		ok = ok && index == next++ && gb == gbs[index];
+	});
+	if (!ok || next != systems.size() / 2)
+		return false;
+	// параметрический порядок
+	typedef MOAlex<8> O1;
+	O1 alex;
+	for (size_t pos = 0; pos < 8; ++pos)
+		alex.A[pos][7] = 1;
+	std::vector<MI<8, O1>> systems1(4), gbs1(4);
+	for (size_t i = 0; i < systems1.size(); ++i)
+	{
+		systems1[i].SetOrder(alex);
+		systems1[i] = systems[i];
+		Buchb<8, O1> bb;
+		bb.Init(MI<8, O1>(alex));
+		bb.Update(systems1[i]);
+		bb.Process();
+		bb.Done(gbs1[i]);
+	}
+	BuchbBatch<8, O1> batch1(pool);
+	batch1.Process(systems1, [&](size_t index, MI<8, O1>& gb)
+	{
+		ok = ok && gb.GetOrder() == alex && gb == gbs1[index];
+	});
+	return ok;
+}
+
+/*
+*******************************************************************************
+Тест testSelfReduce
+
+Параллельные самоприведение и самоминимизация случайных систем. Результаты
+сравниваются с последовательными вычислениями.
+*******************************************************************************
+*/
+
+bool testSelfReduce()
+{
+	typedef MOGrevlex<16> O;
+	Pool pool(4);
+	for (size_t t = 0; t < 20; ++t)
+	{
+		// случайная система с решением 0
+		MI<16, O> s, r, r1, m, m1;
+		for (size_t i = 0; i < 50 + 10 * t; ++i)
+		{
+			MP<16, O> poly;
+			for (size_t j = 0; j < 2 + t % 5; ++j)
+				poly += MM<16>(Env::Rand() % 16, Env::Rand() % 16);
+			poly += poly.Calc(WW<16>());
+			if (poly != 0)
+				s.Insert(poly);
+		}
+		(r = s).SelfReduce(), (r1 = s).SelfReduce(pool);
+		(m = s).SelfMinimize(), (m1 = s).SelfMinimize(pool);
+		if (r != r1 || m != m1)
+			return false;
+	}
+	// Buchb с параллельным самоприведением
+	MI<8, MOGrevlex<8>> i(CommuteSystem()), gb;
+	Buchb<8, MOGrevlex<8>> bb;
+	bb.Init();
+	bb.SetPool(&pool);
+	bb.Update(i);
+	bb.Process();
+	bb.Done(gb);
+	return gb.IsGB() && gb.QuotientBasisDim() == word(18);
+}
+
+/*
+*******************************************************************************
+Тест testIsGB
+
+Параллельная проверка базиса Гребнера на системе testCommute.
+*******************************************************************************
+*/
+
+bool testIsGB()
+{
+	typedef MOGrevlex<8> O;
+	MI<8, O> i(CommuteSystem()), gb;
+	Buchb<8, O> bb;
+	bb.Init();
+	bb.Update(i);
+	bb.Process();
+	bb.Done(gb);
+	Pool pool(4);
+	MI<8, O>::Pair pair;
+	if (!gb.IsGB(pool) || i.IsGB(pool, &pair) || pair.pos1 >= i.Size())
+		return false;
+	// S-многочлен пары не приводится к нулю
+	MP<8, O> poly;
+	auto iter = i.begin();
+	std::advance(iter, pair.pos1);
+	if (pair.pos2 == SIZE_MAX)
+		poly.SPoly(pair.var, *iter);
+	else
+	{
+		auto iter1 = i.begin();
+		std::advance(iter1, pair.pos2);
+		poly.SPoly(*iter, *iter1);
+	}
+	i.Reduce(poly);
+	return poly != 0;
+}
+
+/*
+*******************************************************************************
+Тест testQuotientBasis
+
+Перечисление базиса факторкольца для случайных систем. Число элементов 
+сравнивается с QuotientBasisDim(), элементы проверяются на приведенность.
+*******************************************************************************
+*/
+
+bool testQuotientBasis()
+{
+	typedef MOGrevlex<12> O;
+	Buchb<12, O> bb;
+	for (size_t t = 0; t < 10; ++t)
+	{
+		// случайная квадратичная система
+		MI<12, O> s, gb;
+		for (size_t i = 0; i < 2 + t % 5; ++i)
+		{
+			MP<12, O> poly;
+			for (size_t j = 0; j < 6; ++j)
+				poly += MM<12>(Env::Rand() % 12, Env::Rand() % 12);
+			poly += bool(Env::Rand() % 2);
+			if (poly != 0)
+				s.Insert(poly);
+		}
+		bb.Init();
+		bb.Update(s);
+		bb.Process();
+		bb.Done(gb);
+		// перечисление
+		size_t count = 0;
+		bool ok = true;
+		size_t dim = gb.EnumQuotientBasis([&](const MM<12>& mon)
+		{
+			MP<12, O> poly;
+			poly = mon;
+			gb.Reduce(poly);
+			ok = ok && poly == mon;
+			++count;
+		});
+		// базис целиком
+		MP<12, MOLex<12>> basis;
+		if (!ok || dim != count || gb.QuotientBasisDim() != word(dim) ||
+			gb.QuotientBasis(basis) != dim || basis.Size() != dim)
+			return false;
+	}
+	return true;
+}
+
+/*
+*******************************************************************************
+Тест testQuotientBasisDim
+
+Параллельный расчет размерности базиса факторкольца для случайных 
+мономиальных идеалов. Результаты сравниваются с последовательными.
+*******************************************************************************
+*/
+
+bool testQuotientBasisDim()
+{
+	typedef MOGrevlex<48> O;
+	Pool pool(4);
+	for (size_t t = 0; t < 24; ++t)
+	{
+		MI<48, O> s;
+		for (size_t i = 0; i < 10 + 2 * t; ++i)
+		{
+			MM<48> m;
+			for (size_t d = 2 + Env::Rand() % 3; d--;)
+				m.Set(Env::Rand() % (8 + t), 1);
+			s.Insert(MP<48, O>(m));
+		}
+		if (s.QuotientBasisDim() != s.QuotientBasisDim(pool))
+			return false;
+	}
+	return true;
+}
+
+/*
+*******************************************************************************
+Тест testExhaust
+
+Перебор решений системы testCommute (число решений сравнивается 
+с QuotientBasisDim()) и случайных систем с большим числом уравнений
+(решения сравниваются с найденными прямой подстановкой).
+*******************************************************************************
+*/
+
+bool testExhaust()
+{
+	Pool pool(4);
+	// система testCommute
+	typedef MOGrevlex<8> O;
+	MI<8, O> i(CommuteSystem());
+	Exhaust<8, O> exhaust(pool);
+	bool ok = true;
+	size_t count = exhaust.Process(i, [&](const WW<8>& x)
+	{
+		for (auto iter = i.begin(); iter != i.end(); ++iter)
+			ok = ok && !iter->Calc(x);
+	});
+	if (!ok || count != 18)
+		return false;
+	// случайные системы
+	Exhaust<14, MOGrlex<14>> exhaust1(pool);
+	for (size_t t = 0; t < 10; ++t)
+	{
+		MI<14, MOGrlex<14>> s;
+		for (size_t e = 0; e < 20 + 10 * t; ++e)
+		{
+			MP<14, MOGrlex<14>> poly;
+			for (size_t j = 0; j < 4; ++j)
+			{
+				MM<14> m;
+				for (size_t d = Env::Rand() % (2 + t % 3); d--;)
+					m.Set(Env::Rand() % 14, 1);
+				poly += m;
+			}
+			if (poly != 0)
+				s.Insert(poly);
+		}
+		// прямая подстановка
+		std::vector<bool> sols(1 << 14, false);
+		word vars = s.GatherVars().GetWord(0);
+		count = 0;
+		for (word v = 0; v < (1 << 14); ++v)
+		{
+			if (v & ~vars)
+				continue;
+			WW<14> x;
+			x = v;
+			auto iter = s.begin();
+			while (iter != s.end() && !iter->Calc(x))
+				++iter;
+			if (iter == s.end())
+				sols[v] = true, ++count;
+		}
+		// перебор
+		size_t found = exhaust1.Process(s, [&](const WW<14>& x)
+		{
+			ok = ok && sols[x.GetWord(0)];
+			sols[x.GetWord(0)] = false;
+		});
+		if (!ok || found != count)
+			return false;
+	}
+	return true;
+}
+
+/*
+*******************************************************************************
+Тест testEval
+
+Вычисление случайных многочленов и систем во многих точках. Результаты
+сравниваются с MP::Calc().
+*******************************************************************************
+*/
+
+bool testEval()
+{
+	typedef MOGrevlex<70> O;
+	for (size_t t = 0; t < 10; ++t)
+	{
+		// случайная система
+		MI<70, O> s;
+		for (size_t e = 0; e < 1 + t; ++e)
+		{
+			MP<70, O> poly;
+			for (size_t j = 0; j < 30; ++j)
+			{
+				MM<70> m;
+				for (size_t d = Env::Rand() % 5; d--;)
+					m.Set(Env::Rand() % 70, 1);
+				poly += m;
+			}
+			if (poly != 0)
+				s.Insert(poly);
+		}
+		// случайные точки (их число не кратно размеру блока)
+		std::vector<WW<70>> points(100 + 300 * t);
+		for (size_t i = 0; i < points.size(); ++i)
+			points[i].Rand();
+		// система
+		Eval<70, 4> eval(s);
+		std::vector<word> res;
+		eval.Calc(points, res);
+		size_t stride = (points.size() + B_PER_W - 1) / B_PER_W;
+		if (eval.Size() != s.Size() || res.size() != s.Size() * stride)
+			return false;
+		size_t j = 0;
+		for (auto iter = s.begin(); iter != s.end(); ++iter, ++j)
+			for (size_t i = 0; i < stride * B_PER_W; ++i)
+				if ((res[j * stride + i / B_PER_W] >> i % B_PER_W & 1) !=
+					(i < points.size() && iter->Calc(points[i])))
+					return false;
+		// многочлен
+		Eval<70> eval1(s.front());
+		eval1.Calc(points, res);
+		for (size_t i = 0; i < points.size(); ++i)
+			if ((res[i / B_PER_W] >> i % B_PER_W & 1) != 
+				s.front().Calc(points[i]))
+				return false;
+	}
+	return true;
+}
+
+/*
+*******************************************************************************
+Тест testMat
+
+Приведение случайных матриц неполного ранга, в том числе с нулевыми
+столбцами, к ступенчатому виду (результаты сравниваются с приведением
+методом Гаусса), построение ядра,
+решение систем, обмен строками со словами WW.
+*******************************************************************************
+*/
+
+bool testMat()
+{
+	Pool pool(4);
+	for (size_t t = 0; t < 20; ++t)
+	{
+		// случайная матрица ранга не выше rank
+		size_t rows = 50 + 37 * t, cols = 30 + 61 * t, rank = 10 + 20 * t;
+		Mat base(rank, cols), a(rows, cols);
+		base.Rand();
+		// при нечетных t 3/4 столбцов нулевые: полосы с малым числом
+		// опорных столбцов
+		if (t % 2)
+			for (size_t j = 0; j < cols; ++j)
+				if (j / 5 % 4 != 0)
+					for (size_t i = 0; i < rank; ++i)
+						base.Set(i, j, 0);
+		for (size_t i = 0; i < rows; ++i)
+			for (size_t j = 0; j < rank; ++j)
+				if (Env::Rand() % 3 == 0)
+					for (size_t pos = 0; pos < a.Stride(); ++pos)
+						a.Row(i)[pos] ^= base.Row(j)[pos];
+		// метод Гаусса
+		Mat g(a);
+		size_t r = 0;
+		for (size_t c = 0; c < cols && r < rows; ++c)
+		{
+			size_t p = r;
+			while (p < rows && !g.Get(p, c))
+				++p;
+			if (p == rows)
+				continue;
+			g.SwapRows(p, r);
+			for (size_t i = 0; i < rows; ++i)
+				if (i != r && g.Get(i, c))
+					g.AddRow(i, r);
+			++r;
+		}
+		// метод четырех русских
+		Mat e(a), e1(a);
+		if (e.Echelon() != r || e != g || e1.Echelon(pool) != r || e1 != g ||
+			a.Rank() != r)
+			return false;
+		// ядро
+		Mat ker;
+		std::vector<word> x, y;
+		if (a.Kernel(ker) != cols - r || ker.Rank() != cols - r)
+			return false;
+		for (size_t i = 0; i < ker.Rows(); ++i)
+		{
+			x.assign(ker.Row(i), ker.Row(i) + ker.Stride());
+			a.Mult(x, y);
+			for (size_t pos = 0; pos < y.size(); ++pos)
+				if (y[pos] != 0)
+					return false;
+		}
+		// совместная система
+		Mat x0(1, cols);
+		x0.Rand();
+		std::vector<word> b;
+		a.Mult(std::vector<word>(x0.Row(0), x0.Row(0) + x0.Stride()), b);
+		if (!a.Solve(b, x))
+			return false;
+		a.Mult(x, y);
+		if (y != b)
+			return false;
+	}
+	// обмен строками со словами
+	Mat a(3, 100);
+	WW<100> w, w1;
+	w.Rand();
+	a.SetRow(1, w), a.GetRow(1, w1);
+	return w == w1 && a.Rank() == 1 && a.Get(1, 99) == w.Test(99);
+}
+
+/*
+*******************************************************************************
+Тест testSMat
+
+Ранг, решение систем и младшая часть пространства строк случайных
+разреженных матриц (результаты сравниваются с плотными матрицами),
+векторы ядра, матрицы Маколея систем многочленов.
+*******************************************************************************
+*/
+
+bool testSMat()
+{
+	Pool pool(4);
+	for (size_t t = 0; t < 20; ++t)
+	{
+		// разреженная матрица с зависимыми строками
+		size_t rows = 40 + 31 * t, cols = (t % 3 == 0) ? rows : 30 + 43 * t;
+		SMat a(rows, cols);
+		Mat d(rows, cols);
+		for (size_t i = 0; i < rows; ++i)
+		{
+			if (i > 3 && Env::Rand() % 5 == 0)
+			{
+				// сумма двух предыдущих строк
+				size_t i1 = Env::Rand() % i, i2 = Env::Rand() % i;
+				for (size_t j : a.Row(i1))
+					a.Flip(i, j), d.Flip(i, j);
+				for (size_t j : a.Row(i2))
+					a.Flip(i, j), d.Flip(i, j);
+				continue;
+			}
+			for (size_t k = Env::Rand() % 5; k--;)
+			{
+				size_t j = Env::Rand() % cols;
+				a.Flip(i, j), d.Flip(i, j);
+			}
+		}
+		// ранг
+		size_t r = d.Rank();
+		if (a.Rank() != r)
+			return false;
+		// совместная система
+		Mat x0(1, cols);
+		x0.Rand();
+		std::vector<word> b, x, y;
+		a.Mult(std::vector<word>(x0.Row(0), x0.Row(0) + x0.Stride()), b);
+		if (!a.Solve(b, x))
+			return false;
+		a.Mult(x, y);
+		if (y != b)
+			return false;
+		// младшая часть
+		SMat tail;
+		size_t first = cols / 3 + t;
+		Mat e(d);
+		e.Echelon();
+		size_t dim = 0;
+		for (size_t i = 0; i < r; ++i)
+			if (e.Lead(i) >= first)
+				++dim;
+		if (a.Tail(first, tail, &pool) != dim || tail.Cols() != cols)
+			return false;
+		for (size_t i = 0; i < dim; ++i)
+			for (size_t j = 0; j < cols; ++j)
+				if (tail.Get(i, j) != e.Get(r - dim + i, j))
+					return false;
+		// векторы ядра
+		Mat ker;
+		size_t want = t % 4 == 0 ? 100 : 3;
+		size_t count = std::min<size_t>(want, cols - r);
+		if ((t % 2 ? a.Kernel(pool, ker, want) : a.Kernel(ker, want)) != 
+			count || ker.Rank() != count)
+			return false;
+		for (size_t i = 0; i < ker.Rows(); ++i)
+		{
+			x.assign(ker.Row(i), ker.Row(i) + ker.Stride());
+			a.Mult(x, y);
+			for (size_t pos = 0; pos < y.size(); ++pos)
+				if (y[pos] != 0)
+					return false;
+		}
+		// умножение на блок векторов
+		std::vector<word> xb(cols), yb, yb1;
+		Env::RandMem(xb.data(), cols * sizeof(word));
+		a.MultBlock(xb, yb), a.MultBlock(pool, xb, yb1);
+		if (yb != yb1)
+			return false;
+		SMat at;
+		a.Transpose(at);
+		for (size_t lane = 0; lane < B_PER_W; lane += 13)
+		{
+			x.assign(x0.Stride(), 0);
+			for (size_t j = 0; j < cols; ++j)
+				x[j / B_PER_W] |= (xb[j] >> lane & 1) << j % B_PER_W;
+			a.Mult(x, y);
+			for (size_t i = 0; i < rows; ++i)
+				if ((yb[i] >> lane & 1) != (y[i / B_PER_W] >> i % B_PER_W & 1))
+					return false;
+		}
+		if (at.Rows() != cols || at.Rank() != r)
+			return false;
+	}
+	// матрица Маколея
+	typedef MOGrevlex<16> O;
+	MI<16, O> s, s1;
+	for (size_t e = 0; e < 30; ++e)
+	{
+		MP<16, O> poly;
+		for (size_t j = 0; j < 5; ++j)
+		{
+			MM<16> m;
+			for (size_t deg = Env::Rand() % 4; deg--;)
+				m.Set(Env::Rand() % 16, 1);
+			poly += m;
+		}
+		if (poly != 0)
+			s.Insert(poly);
+	}
+	SMat a;
+	MP<16, O> mons;
+	a.From(s, mons);
+	if (a.Rows() != s.Size() || a.Cols() != mons.Size())
+		return false;
+	a.To(s1, mons);
+	return s1 == s;
+}
+
+/*
+*******************************************************************************
+Тест testXL
+
+Решение случайных квадратичных систем с одним, несколькими и без решений
+алгоритмами XL и MutantXL (результаты сравниваются с перебором решений).
+*******************************************************************************
+*/
+
+template<class _O> bool testXL(Pool& pool)
+{
+	const size_t n = 10;
+	for (size_t t = 0; t < 10; ++t)
+	{
+		// квадратичная система с решением x0
+		MI<n, _O> s, lin;
+		WW<n> x0;
+		x0.Rand();
+		RandSystem(s, x0, 8 + 2 * t, 8, 2, t % 4 == 3 ? SIZE_MAX : 0);
+		// перебор
+		std::vector<WW<n>> sols;
+		Exhaust<n, _O> exhaust(pool);
+		exhaust.Process(s, [&](const WW<n>& x) { sols.push_back(x); });
+		// аффинная оболочка решений
+		size_t dim = 0;
+		if (!sols.empty())
+		{
+			Mat d(sols.size(), n);
+			for (size_t i = 0; i < sols.size(); ++i)
+				d.SetRow(i, sols[i] ^ sols[0]);
+			dim = d.Rank();
+		}
+		XL<n, _O> xl;
+		xl.SetMutants(t % 2 == 0);
+		xl.SetPool(t % 3 ? &pool : 0);
+		bool solved = xl.Process(s, lin);
+		if (sols.empty())
+		{
+			if (!solved || lin.Size() != 1 || lin.front() != 1)
+				return false;
+			continue;
+		}
+		size_t vars = s.GatherVars().Weight();
+		if (solved != (dim == 0 && lin.Size() == vars) ||
+			lin.Size() != vars - dim || xl.GetDeg() > vars)
+			return false;
+		for (auto iter = lin.begin(); iter != lin.end(); ++iter)
+		{
+			if (iter->Deg() > 1)
+				return false;
+			for (size_t i = 0; i < sols.size(); ++i)
+				if (iter->Calc(sols[i]))
+					return false;
+		}
+	}
+	return true;
+}
+
+bool testXL()
+{
+	Pool pool(4);
+	return testXL<MOGrevlex<10>>(pool) && testXL<MOLex<10>>(pool);
+}
+
+/*
+*******************************************************************************
+Тест testElimLin
+
+Упрощение случайных систем, которые содержат линейные соотношения
+(решения исходной и упрощенной систем сравниваются перебором).
+*******************************************************************************
+*/
+
+template<class _O> bool testElimLin(Pool& pool)
+{
+	const size_t n = 14;
+	for (size_t t = 0; t < 10; ++t)
+	{
+		// квадратичные и линейные многочлены, решение x0
+		MI<n, _O> s, s1;
+		WW<n> x0;
+		x0.Rand();
+		RandSystem(s, x0, 6 + t / 2, 6);
+		RandSystem(s, x0, 4 + t / 2, 6, 1);
+		// линейные соотношения, скрытые в сумме квадратичных
+		for (size_t k = 0; k < 3; ++k)
+		{
+			MP<n, _O> poly(*std::next(s.begin(), Env::Rand() % s.Size()));
+			poly += *std::next(s.begin(), Env::Rand() % s.Size());
+			poly += MM<n>(Env::Rand() % n);
+			if (poly.Calc(x0))
+				poly += 1;
+			if (poly != 0)
+				s.Insert(poly);
+		}
+		// несовместная система
+		if (t == 9)
+			s.Insert(s.front() + MP<n, _O>(true));
+		s1 = s;
+		ElimLin<n, _O> el;
+		el.SetPool(t % 2 ? &pool : 0);
+		bool ok = el.Process(s1);
+		// несовместность
+		std::vector<WW<n>> sols, sols1;
+		Exhaust<n, _O> exhaust(pool);
+		exhaust.Process(s, [&](const WW<n>& x) { sols.push_back(x); });
+		if (!ok)
+		{
+			if (!sols.empty() || s1.Size() != 1 || s1.front() != 1)
+				return false;
+			continue;
+		}
+		if (el.GetStat().vars != el.GetEliminated().size() ||
+			el.GetStat().polys_after != s1.Size() ||
+			s1.Size() > 0 && s1.MinDeg() < 2)
+			return false;
+		// решения исходной системы удовлетворяют соотношениям
+		for (size_t i = 0; i < sols.size(); ++i)
+		{
+			for (auto iter = s1.begin(); iter != s1.end(); ++iter)
+				if (iter->Calc(sols[i]))
+					return false;
+			for (auto& e : el.GetEliminated())
+				if (sols[i].Test(e.first) != e.second.Calc(sols[i]))
+					return false;
+		}
+		// решения упрощенной системы дают решения исходной
+		exhaust.Process(s1, [&](const WW<n>& x) { sols1.push_back(x); });
+		MM<n> vars = s.GatherVars(), vars1 = s1.GatherVars();
+		size_t free = vars.Weight() - vars1.Weight() - el.GetStat().vars;
+		if (sols.size() != (sols1.size() << free))
+			return false;
+		for (size_t i = 0; i < sols1.size(); ++i)
+		{
+			el.Restore(sols1[i]);
+			for (auto iter = s.begin(); iter != s.end(); ++iter)
+				if (iter->Calc(sols1[i]))
+					return false;
+		}
+	}
+	return true;
+}
+
+bool testElimLin()
+{
+	Pool pool(4);
+	return testElimLin<MOGrevlex<14>>(pool) && testElimLin<MOLex<14>>(pool);
+}
+
+/*
+*******************************************************************************
+Тест testSubstitute
+
+Одновременная замена переменных (результаты сравниваются со значениями
+многочленов и с последовательными заменами Replace()).
+*******************************************************************************
+*/
+
+bool testSubstitute()
+{
+	const size_t n = 12;
+	Pool pool(4);
+	for (size_t t = 0; t < 20; ++t)
+	{
+		// система
+		MI<n, MOGrevlex<n>> s;
+		for (size_t e = 0; e < 8; ++e)
+		{
+			MP<n, MOGrevlex<n>> poly;
+			for (size_t j = 0; j < 10; ++j)
+			{
+				MM<n> m;
+				for (size_t k = Env::Rand() % 5; k--;)
+					m.Set(Env::Rand() % n, 1);
+				poly += m;
+			}
+			s.insert(s.end(), poly);
+		}
+		// замены: при четном t заменяющие многочлены не содержат
+		// заменяемых переменных
+		std::map<size_t, MP<n, MOLex<n>>> subst;
+		for (size_t k = 0; k < 2 + t % 4; ++k)
+			subst.emplace(Env::Rand() % n, MP<n, MOLex<n>>());
+		for (auto& e : subst)
+			for (size_t j = 0; j < 3; ++j)
+			{
+				MM<n> m;
+				for (size_t k = Env::Rand() % 3; k--;)
+				{
+					size_t v = Env::Rand() % n;
+					if (t % 2 == 0 && subst.count(v))
+						continue;
+					m.Set(v, 1);
+				}
+				e.second += m;
+			}
+		// многочлены
+		for (auto iter = s.begin(); iter != s.end(); ++iter)
+		{
+			MP<n, MOGrevlex<n>> poly(*iter), poly1(*iter);
+			poly.Substitute(subst);
+			if (!poly.IsNormalized())
+				return false;
+			for (size_t i = 0; i < 32; ++i)
+			{
+				WW<n> x, y;
+				x.Rand(), y = x;
+				for (auto& e : subst)
+					y.Set(e.first, e.second.Calc(x));
+				if (poly.Calc(x) != iter->Calc(y))
+					return false;
+			}
+			if (t % 2)
+				continue;
+			for (auto& e : subst)
+				poly1.Replace(e.first, e.second);
+			if (poly != poly1)
+				return false;
+		}
+		// системы
+		MI<n, MOGrevlex<n>> s1(s), s2(s);
+		s1.Substitute(subst);
+		s2.Substitute(subst, pool);
+		if (s1 != s2)
+			return false;
+		for (auto iter = s.begin(); iter != s.end(); ++iter)
+			iter->Substitute(subst);
+		s.Normalize();
+		if (s != s1)
+			return false;
+	}
+	return true;
+}
+
+/*
+*******************************************************************************
+Тест testHybrid
+
+Решение случайных систем угадыванием переменных (решения сравниваются
+с найденными перебором).
+*******************************************************************************
+*/
+
+template<class _O> bool testHybrid(Pool& pool)
+{
+	const size_t n = 12;
+	Exhaust<n, _O> exhaust(pool);
+	Hybrid<n, _O> hybrid(pool);
+	for (size_t t = 0; t < 10; ++t)
+	{
+		// квадратичная система с решением x0 (кроме t == 9)
+		MI<n, _O> s;
+		WW<n> x0;
+		x0.Rand();
+		RandSystem(s, x0, 6 + t, 8, 2, t == 9);
+		// решения
+		std::vector<WW<n>> sols, sols1;
+		exhaust.Process(s, [&](const WW<n>& x) { sols.push_back(x); });
+		hybrid.SetGuess(t % 5);
+		size_t count = hybrid.Process(s, 
+			[&](const WW<n>& x) { sols1.push_back(x); });
+		std::sort(sols.begin(), sols.end());
+		std::sort(sols1.begin(), sols1.end());
+		if (count != sols1.size() || sols != sols1 ||
+			hybrid.GetGuessVars().size() != t % 5 ||
+			hybrid.GetStat().branches != size_t(1) << (t % 5) ||
+			sols.empty() && hybrid.GetStat().inconsistent != 
+				hybrid.GetStat().branches)
+			return false;
+	}
+	return true;
+}
+
+bool testHybrid()
+{
+	Pool pool(4);
+	return testHybrid<MOGrevlex<12>>(pool) && testHybrid<MOLex<12>>(pool);
+}
+
+/*
+*******************************************************************************
+Тест testNormalize
+
+Нормализация многочленов с большим числом мономов (поразрядная сортировка
+сравнивается с сортировкой сравнениями).
+*******************************************************************************
+*/
+
+template<class _O> bool testNormalize()
+{
+	const size_t n = _O::n;
+	for (size_t t = 0; t < 20; ++t)
+	{
+		// мономы от vars переменных, часть мономов повторяется
+		size_t vars = t % 2 ? n : 12;
+		std::list<MM<n>> mons;
+		for (size_t i = 0; i < 100 + 50 * t; ++i)
+		{
+			MM<n> m;
+			for (size_t d = Env::Rand() % 6; d--;)
+				m.Set(Env::Rand() % vars, 1);
+			mons.push_back(m);
+			if (Env::Rand() % 4 == 0)
+				mons.push_back(m);
+		}
+		MP<n, _O> poly;
+		poly.assign(mons.begin(), mons.end());
+		poly.Normalize();
+		// сортировка сравнениями
+		_O order;
+		mons.sort(order);
+		for (auto iter = mons.begin(); iter != mons.end();)
+		{
+			auto next = std::next(iter);
+			if (next != mons.end() && *iter == *next)
+				iter = mons.erase(mons.erase(iter));
+			else
+				iter = next;
+		}
+		if (!poly.IsNormalized() || poly.Size() != mons.size() ||
+			!std::equal(mons.begin(), mons.end(), poly.begin()))
+			return false;
+	}
+	return true;
+}
+
+bool testNormalize()
+{
+	return testNormalize<MOLex<100>>() && testNormalize<MOGrlex<100>>() &&
+		testNormalize<MOGrevlex<100>>() && testNormalize<MOGrevlex<16>>() &&
+		testNormalize<MORev<MOGrlex<100>>>();
+}
+
+/*
+*******************************************************************************
+Тест testRenormalize
+
+Операции, которые меняют часть мономов (умножение на моном, Set(), 
+Replace(), SPoly()), сравниваются с преобразованием всех мономов 
+и нормализацией.
+*******************************************************************************
+*/
+
+template<class _O> bool testRenormalize()
+{
+	const size_t n = _O::n;
+	// случайный многочлен
+	auto rand = [](MP<n, _O>& poly, size_t count)
+	{
+		poly.SetEmpty();
+		for (size_t i = 0; i < count; ++i)
+		{
+			MM<n> m;
+			for (size_t d = Env::Rand() % 5; d--;)
+				m.Set(Env::Rand() % n, 1);
+			poly.push_back(m);
+		}
+		poly.Normalize();
+	};
+	// преобразование всех мономов и нормализация
+	auto apply = [](const MP<n, _O>& poly, MP<n, _O>& res, 
+		std::function<void(MM<n>&)> f)
+	{
+		res.SetEmpty();
+		for (auto iter = poly.begin(); iter != poly.end(); ++iter)
+			res.push_back(*iter), f(res.back());
+		res.Normalize();
+	};
+	for (size_t t = 0; t < 50; ++t)
+	{
+		MP<n, _O> p1, p2, p, q, r;
+		rand(p1, 10 + 5 * t), rand(p2, 10 + 3 * t);
+		if (p1 == 0 || p2 == 0)
+			continue;
+		size_t i = Env::Rand() % n, j = Env::Rand() % n;
+		MM<n> m;
+		for (size_t d = Env::Rand() % 4; d--;)
+			m.Set(Env::Rand() % n, 1);
+		// умножение на моном
+		(p = p1) *= m;
+		apply(p1, q, [&](MM<n>& x) { x *= m; });
+		if (p != q || !p.IsNormalized())
+			return false;
+		// установка значения
+		(p = p1).Set(i, 1);
+		apply(p1, q, [&](MM<n>& x) { x.Set(i, 0); });
+		if (p != q || !p.IsNormalized())
+			return false;
+		// замена переменной
+		(p = p1).Replace(i, j);
+		apply(p1, q, [&](MM<n>& x) 
+		{ 
+			if (i != j && x.Test(i))
+				x.Flip(i), x.Set(j, 1); 
+		});
+		if (p != q || !p.IsNormalized())
+			return false;
+		// S-многочлены
+		p.SPoly(i, p1);
+		apply(p1, q, [&](MM<n>& x) { x.Set(i, 1); });
+		if (p != q || !p.IsNormalized())
+			return false;
+		MM<n> lcm;
+		lcm.LCM(p1.LM(), p2.LM());
+		p.SPoly(p1, p2);
+		apply(p1, q, [&](MM<n>& x) { x *= lcm / p1.LM(); });
+		apply(p2, r, [&](MM<n>& x) { x *= lcm / p2.LM(); });
+		q += r;
+		if (p != q || !p.IsNormalized())
+			return false;
+		(p = p1).SPoly(p2);
+		if (p != q || !p.IsNormalized())
+			return false;
+	}
+	return true;
+}
+
+bool testRenormalize()
+{
+	return testRenormalize<MOLex<10>>() && testRenormalize<MOGrlex<70>>() &&
+		testRenormalize<MOGrevlex<70>>() && 
+		testRenormalize<MORev<MOGrevlex<10>>>();
+}
+
+/*
+*******************************************************************************
+Тест testFGLM
+
+Смена порядка базисов Гребнера случайных систем (результаты сравниваются
+с базисами, вычисленными в целевых порядках непосредственно).
+*******************************************************************************
+*/
+
+template<class _O2> bool testFGLM(size_t sparseDim)
+{
+	const size_t n = 10;
+	typedef MOGrevlex<n> O;
+	Buchb<n, O> bb;
+	Buchb<n, _O2> bb2;
+	FGLM<n, O> fglm;
+	fglm.SetSparseDim(sparseDim);
+	for (size_t t = 0; t < 10; ++t)
+	{
+		// квадратичная система (несовместная при t == 9)
+		MI<n, O> s, gb;
+		WW<n> x0;
+		x0.Rand();
+		RandSystem(s, x0, 2 + t, 6, 2, t == 9);
+		bb.Init(), bb.Update(s), bb.Process(), bb.Done(gb);
+		// базис в целевом порядке
+		MI<n, _O2> s2, gb2, res;
+		s2 = s;
+		bb2.Init(), bb2.Update(s2), bb2.Process(), bb2.Done(gb2);
+		MP<n, O> qb;
+		fglm.Process(gb, res);
+		if (res != gb2 || !res.IsNormalized() ||
+			fglm.GetStat().dim != gb.QuotientBasis(qb) ||
+			fglm.GetStat().sparse != (fglm.GetStat().dim >= sparseDim))
+			return false;
+	}
+	return true;
+}
+
+bool testFGLM()
+{
+	return testFGLM<MOLex<10>>(4096) && testFGLM<MOLex<10>>(0) &&
+		testFGLM<MOGrlex<10>>(4096) && testFGLM<MOGrlex<10>>(0);
+}
+
+/*
+*******************************************************************************
+Тест testMT
+
+Словари мономов: номера мономов (в том числе назначаемые одновременно
+несколькими потоками), ранги, сложение и умножение многочленов
+над номерами (результаты сравниваются с операциями MP), сложение
+после пересчета рангов.
+*******************************************************************************
+*/
+
+template<class _O> bool testMT(Pool& pool)
+{
+	const size_t n = 70;
+	MT<n> table;
+	MTRank<n, _O> rank(table);
+	// номера
+	std::vector<MM<n>> mons(2000);
+	for (size_t i = 0; i < mons.size(); ++i)
+		mons[i] = i % 5 == 4 ? mons[i - 3] : 
+			MM<n>(Env::Rand() % n, Env::Rand() % n, Env::Rand() % n);
+	std::vector<std::vector<MT<n>::Id>> ids(pool.Size(), 
+		std::vector<MT<n>::Id>(mons.size()));
+	pool.Run(pool.Size(), [&](size_t, size_t task)
+	{
+		for (size_t i = 0; i < mons.size(); ++i)
+		{
+			size_t j = task % 2 ? mons.size() - 1 - i : i;
+			ids[task][j] = table.Insert(mons[j]);
+		}
+	});
+	for (size_t i = 0; i < mons.size(); ++i)
+		for (size_t task = 0; task < ids.size(); ++task)
+			if (ids[task][i] != ids[0][i] || table.Get(ids[0][i]) != mons[i] ||
+				table.Find(mons[i]) != ids[0][i])
+				return false;
+	// ранги
+	rank.Update();
+	for (size_t i = 0; i + 1 < mons.size(); ++i)
+		if (rank(ids[0][i], ids[0][i + 1]) != 
+			rank.GetOrder()(mons[i], mons[i + 1]))
+			return false;
+	// многочлены
+	for (size_t t = 0; t < 20; ++t)
+	{
+		MP<n, _O> p1, p2, q;
+		for (size_t i = 0; i < 100; ++i)
+			p1 += mons[Env::Rand() % mons.size()], 
+			p2 += mons[Env::Rand() % mons.size()];
+		MTP<n, _O> t1(table, rank), t2(table, rank);
+		t1.From(p1), t2.From(p2);
+		if (t1.To(q) != p1 || (t1 == t2) != (p1 == p2))
+			return false;
+		t1 += t2, p1 += p2;
+		if (t1.To(q) != p1 || !q.IsNormalized())
+			return false;
+		MM<n> m(Env::Rand() % n, Env::Rand() % n);
+		t1 *= m, p1 *= m;
+		if (t1.To(q) != p1 || !q.IsNormalized())
+			return false;
+		// ранги пересчитываются после этапа умножений
+		t2 *= m, p2 *= m;
+		rank.Update();
+		if (!rank.IsCurrent())
+			return false;
+		t1 += t2, p1 += p2;
+		if (t1.To(q) != p1 || !q.IsNormalized())
+			return false;
+	}
+	return true;
+}
+
+bool testMT()
+{
+	Pool pool(4);
+	return testMT<MOLex<70>>(pool) && testMT<MOGrevlex<70>>(pool);
+}
+
+/*
+*******************************************************************************
+Тест testIO
+
+Сохранение и загрузка слов, мономов, многочленов и систем в двоичном 
+формате.
+*******************************************************************************
+*/
+
+bool testIO()
+{
+	const char* path = "testgf2.bin";
+	// слова и мономы
+	WW<70> w, w1;
+	w.Rand();
+	if (!Save(path, w) || !Load(path, w1) || w != w1)
+		return false;
+	MM<70> m(1, 3, 69), m1;
+	if (!Save(path, m) || !Load(path, m1) || m != m1 || Load(path, w1))
+		return false;
+	// многочлены
+	MP<70, MOGrevlex<70>> p, p1;
+	for (size_t i = 0; i < 100; ++i)
+		m.Rand(), p += m;
+	if (!Save(path, p) || !Load(path, p1) || p != p1)
+		return false;
+	// системы
+	MI<8, MOGrevlex<8>> i(CommuteSystem()), i1;
+	MI<8, MOLex<8>> i2, i3;
+	i2 = i;
+	if (!Save(path, i) || !Load(path, i1) || i != i1 ||
+		!Load(path, i3) || i2 != i3 || !i3.IsNormalized())
+		return false;
+	// испорченный файл
+	std::FILE* fp = std::fopen(path, "r+b");
+	if (!fp || std::fseek(fp, 10, SEEK_SET) != 0 || std::fputc(0xFF, fp) < 0)
+		return false;
+	std::fclose(fp);
+	bool ret = !Load(path, i1);
+	std::remove(path);
+	return ret && !Load(path, i1);
+}
+
+/*
+*******************************************************************************
+Тест testText
+
+Быстрый разбор и форматирование текстового представления многочленов и 
+систем, сравнение с операторами ввода-вывода в поток.
+*******************************************************************************
+*/
+
+bool testText()
+{
+	typedef MOGrlex<70> O;
+	// многочлен
+	MP<70, O> p, p1;
+	MM<70> m;
+	for (size_t i = 0; i < 100; ++i)
+		m.Rand(), p += m;
+	p += true;
+	string str;
+	Format(str, p);
+	stringstream ss;
+	ss << p;
+	const char* ptr = str.c_str();
+	if (str != ss.str() || !Parse(ptr, ptr + str.size(), p1) || p != p1 ||
+		*ptr != 0)
+		return false;
+	// система
+	str = "{ x0 x3 + x1 x2 + 1, x1 x6 + x2 x5 + x1 x6 + 0,\n"
+		"  x01 x7 + x3 x5 + x0 x5 + x1 x4, x2 x5, x1 x1 + 1}";
+	MI<70, O> i, i1;
+	ss.str("");
+	ss << "{ x0 x3 + x1 x2 + 1, x2 x5, x1 x7 + x3 x5 + x0 x5 + x1 x4 }";
+	ss >> i;
+	ptr = str.c_str();
+	if (Parse(ptr, ptr + str.size(), i1))
+		return false;
+	str.replace(str.find("x1 x1"), 5, "x1");
+	ptr = str.c_str();
+	i.Insert(MM<70>(1) + true);
+	if (!Parse(ptr, ptr + str.size(), i1) || i1 != i)
+		return false;
+	str.clear(), ss.str("");
+	Format(str, i), ss << i;
+	if (str != ss.str())
+		return false;
+	// ошибки
+	static const char* errors[] = { "x1x2", "x70", "x", "+", "x1 +", "" };
+	for (size_t pos = 0; pos < sizeof(errors) / sizeof(errors[0]); ++pos)
+	{
+		ptr = errors[pos];
+		if (Parse(ptr, ptr + strlen(ptr), p1))
+			return false;
+	}
+	return true;
+}
+
 /*
 *******************************************************************************
 main
@@ -546,6 +2061,7 @@ int main()
 	Env::Print("gf2/test [gf2 version %s]\n", Env::Version());
 	ret |= !Env::RunTest("testWW", testWW);
 	ret |= !Env::RunTest("testMP", testMP);
+	ret |= !Env::RunTest("testMMTree", testMMTree);
 	ret |= !Env::RunTest("testOder", testOrder);
 	ret |= !Env::RunTest("testBFunc", testBFunc);
 	ret |= !Env::RunTest("testBent", testBent);
@@ -556,5 +2072,27 @@ int main()
 	ret |= !Env::RunTest("testBash2", testBash2);
 	ret |= !Env::RunTest("testCommute", testCommute);
 	ret |= !Env::RunTest("testEM", testEM);
+	ret |= !Env::RunTest("testCheckpoint", testCheckpoint);
+	ret |= !Env::RunTest("testCPSel", testCPSel);
+	ret |= !Env::RunTest("testBuchbSig", testBuchbSig);
+	ret |= !Env::RunTest("testBatch", testBatch);
+	ret |= !Env::RunTest("testSelfReduce", testSelfReduce);
+	ret |= !Env::RunTest("testIsGB", testIsGB);
+	ret |= !Env::RunTest("testQuotientBasis", testQuotientBasis);
+	ret |= !Env::RunTest("testQuotientBasisDim", testQuotientBasisDim);
+	ret |= !Env::RunTest("testExhaust", testExhaust);
+	ret |= !Env::RunTest("testEval", testEval);
+	ret |= !Env::RunTest("testMat", testMat);
+	ret |= !Env::RunTest("testSMat", testSMat);
+	ret |= !Env::RunTest("testXL", testXL);
+	ret |= !Env::RunTest("testElimLin", testElimLin);
+	ret |= !Env::RunTest("testSubstitute", testSubstitute);
+	ret |= !Env::RunTest("testHybrid", testHybrid);
+	ret |= !Env::RunTest("testNormalize", testNormalize);
+	ret |= !Env::RunTest("testRenormalize", testRenormalize);
+	ret |= !Env::RunTest("testFGLM", testFGLM);
+	ret |= !Env::RunTest("testMT", testMT);
+	ret |= !Env::RunTest("testIO", testIO);
+	ret |= !Env::RunTest("testText", testText);
 	return ret;
 }